@@ -0,0 +1,97 @@
+#include "battery_history.h"
+#include <pebble.h>
+
+// Battery discharge trend for the hours-left widget: a ring of (time, percent)
+// samples fed by the face's battery events and kept in persist, so the trend
+// survives restarts and spans the time the face wasn't running. The drain
+// rate is only recomputed when a sample is added.
+
+#define BATTERY_HISTORY_PERSIST_KEY 4
+
+typedef struct {
+    uint32_t time;
+    uint8_t percent;
+} BatterySample;
+
+// Ring buffer, written to persist as one blob
+typedef struct {
+    uint8_t head;  // Next slot to write
+    uint8_t count;
+    BatterySample samples[BATTERY_HISTORY_SIZE];
+} BatteryHistory;
+
+static BatteryHistory s_history;
+static int s_percent = 0;
+static int s_drain_tenths = 0; // Tenths of a percent per hour, 0 = unknown
+
+// Drain across the ring, oldest to newest sample, in tenths of a percent per
+// hour; 0 if unknown
+static int drain_rate(void) {
+    if (s_history.count < 2) return 0;
+    int newest = (s_history.head + BATTERY_HISTORY_SIZE - 1) % BATTERY_HISTORY_SIZE;
+    int oldest = (s_history.head + BATTERY_HISTORY_SIZE - s_history.count) % BATTERY_HISTORY_SIZE;
+    int32_t dropped = s_history.samples[oldest].percent - s_history.samples[newest].percent;
+    int32_t seconds = (int32_t)(s_history.samples[newest].time - s_history.samples[oldest].time);
+    if (dropped <= 0 || seconds <= 0) return 0;
+    return (int)(dropped * 10 * SECONDS_PER_HOUR / seconds);
+}
+
+// Most recent sample, or -1 if there is none
+static int last_percent(void) {
+    if (s_history.count == 0) return -1;
+    int newest = (s_history.head + BATTERY_HISTORY_SIZE - 1) % BATTERY_HISTORY_SIZE;
+    return s_history.samples[newest].percent;
+}
+
+// O(1) append; the oldest sample is overwritten once the ring is full
+static void append(uint8_t percent) {
+    s_history.samples[s_history.head] = (BatterySample) {
+        .time = (uint32_t)time(NULL),
+        .percent = percent
+    };
+    s_history.head = (s_history.head + 1) % BATTERY_HISTORY_SIZE;
+    if (s_history.count < BATTERY_HISTORY_SIZE) {
+        s_history.count++;
+    }
+    persist_write_data(BATTERY_HISTORY_PERSIST_KEY, &s_history, sizeof(s_history));
+}
+
+static void clear(void) {
+    if (s_history.count == 0) return;
+    s_history.head = 0;
+    s_history.count = 0;
+    persist_write_data(BATTERY_HISTORY_PERSIST_KEY, &s_history, sizeof(s_history));
+}
+
+// Read the ring saved by an earlier run; cheap enough for before the first frame
+void battery_history_load(void) {
+    if (!persist_exists(BATTERY_HISTORY_PERSIST_KEY) ||
+        persist_read_data(BATTERY_HISTORY_PERSIST_KEY, &s_history, sizeof(s_history)) !=
+            (int)sizeof(s_history) ||
+        s_history.head >= BATTERY_HISTORY_SIZE || s_history.count > BATTERY_HISTORY_SIZE) {
+        memset(&s_history, 0, sizeof(s_history));
+    }
+    s_percent = last_percent();
+    s_drain_tenths = drain_rate();
+}
+
+// Record a battery event; true if the hours-left estimate may have changed
+bool battery_history_update(BatteryChargeState state) {
+    if (state.is_charging || state.is_plugged) {
+        // A charge invalidates the discharge trend
+        clear();
+    } else if (state.charge_percent != last_percent()) {
+        append(state.charge_percent);
+    } else {
+        return false;
+    }
+    s_percent = state.charge_percent;
+    s_drain_tenths = drain_rate();
+    return true;
+}
+
+// Estimated hours of battery left from the trend, or -1 while unknown
+int battery_history_hours_left(void) {
+    if (s_drain_tenths <= 0 || s_percent < 0) return -1;
+    return s_percent * 10 / s_drain_tenths;
+}
@@ -0,0 +1,14 @@
+#ifndef BATTERY_HISTORY_H
+#define BATTERY_HISTORY_H
+
+#include <pebble.h>
+
+// Samples kept for the discharge trend, one per percent drop since the last charge
+#define BATTERY_HISTORY_SIZE 16
+
+// Function declarations
+void battery_history_load(void);
+bool battery_history_update(BatteryChargeState state);
+int battery_history_hours_left(void);
+
+#endif // BATTERY_HISTORY_H
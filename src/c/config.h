@@ -2,18 +2,30 @@
 #define CONFIG_H
 
 #include "widgets.h"
+#include "sweep.h"
+#include "power.h"
+#include "sun.h"
 
 // Default settings for new users
 #define DEFAULT_DARK_MODE false
 #define DEFAULT_USE_24_HOUR_FORMAT false
 #define DEFAULT_USE_TWO_LETTER_DAY false
 #define DEFAULT_DEBUG_MODE false
-#define DEFAULT_DEBUG_LOGGING false
+#define DEFAULT_DEBUG_LOGGING false // Unused, log verbosity is LOG_LEVEL in log.h
 #define DEFAULT_SHOW_SECOND_DOT true
 #define DEFAULT_SHOW_HOUR_MINUTE_DOTS true
 #define DEFAULT_STEP_GOAL 10000
 #define DEFAULT_TOP_LEFT_WIDGET WIDGET_DAY_DATE
 #define DEFAULT_TOP_RIGHT_WIDGET WIDGET_BATTERY_INDICATOR
+#define DEFAULT_SMOOTH_SWEEP false
+// DEFAULT_SWEEP_FPS lives in sweep.h next to the FPS limits, and
+// DEFAULT_POWER_SAVER_THRESHOLD and DEFAULT_TAP_BURST_SECONDS in power.h
+#define DEFAULT_TAP_TO_WAKE false
+#define DEFAULT_NIGHT_SCHEDULE false
+#define DEFAULT_FOLLOW_QUIET_TIME true
+#define DEFAULT_HEART_RATE_PERIOD 600 // Seconds; 0 leaves sampling to the system
+#define DEFAULT_SECOND_TZ_OFFSET 0 // Minutes east of UTC
+#define DEFAULT_BACKGROUND_WORKER false // Opt-in, launching it can prompt the user
 
 // Function to get default widget configuration
 static inline WidgetConfig get_default_widget_config() {
@@ -35,7 +47,21 @@ static inline Settings get_default_settings() {
         .show_second_dot = DEFAULT_SHOW_SECOND_DOT,
         .show_hour_minute_dots = DEFAULT_SHOW_HOUR_MINUTE_DOTS,
         .step_goal = DEFAULT_STEP_GOAL,
-        .widget_config = get_default_widget_config()
+        .widget_config = get_default_widget_config(),
+        .smooth_sweep = DEFAULT_SMOOTH_SWEEP,
+        .sweep_fps = DEFAULT_SWEEP_FPS,
+        .power_saver_threshold = DEFAULT_POWER_SAVER_THRESHOLD,
+        .tap_to_wake = DEFAULT_TAP_TO_WAKE,
+        .tap_burst_seconds = DEFAULT_TAP_BURST_SECONDS,
+        .night_schedule = DEFAULT_NIGHT_SCHEDULE,
+        .night_start_hour = DEFAULT_NIGHT_START_HOUR,
+        .night_end_hour = DEFAULT_NIGHT_END_HOUR,
+        .follow_quiet_time = DEFAULT_FOLLOW_QUIET_TIME,
+        .heart_rate_period = DEFAULT_HEART_RATE_PERIOD,
+        .latitude_e2 = SUN_NO_LOCATION,
+        .longitude_e2 = SUN_NO_LOCATION,
+        .second_tz_offset = DEFAULT_SECOND_TZ_OFFSET,
+        .background_worker = DEFAULT_BACKGROUND_WORKER
     };
     return settings;
 }
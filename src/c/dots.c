@@ -0,0 +1,103 @@
+#include "dots.h"
+#include <pebble.h>
+#include "log.h"
+#include "invalidate.h"
+
+// Pre-rasterized dot stamps, generated at build time by tools/glyphgen.py
+static GBitmap *s_dot_sprites = NULL;
+
+// Swap a palette entry's colour for its dark mode counterpart, keeping alpha
+// so the anti-aliased edge pixels survive the inversion
+static GColor invert_dot_color(GColor color) {
+    GColor inverted = color;
+    if (color.r == color.g && color.g == color.b) {
+        // Black <-> white and dark gray <-> light gray are mirror images
+        inverted.r = inverted.g = inverted.b = 3 - color.r;
+    }
+    return inverted;
+}
+
+// Function to invert the dot palette for dark mode
+static void invert_dot_palette(GBitmap *bitmap) {
+    if (!bitmap) return;
+    GColor *palette = gbitmap_get_palette(bitmap);
+    if (!palette) return;
+    int palette_size = 0;
+    switch (gbitmap_get_format(bitmap)) {
+        case GBitmapFormat1BitPalette:
+            palette_size = 2;
+            break;
+        case GBitmapFormat2BitPalette:
+            palette_size = 4;
+            break;
+        case GBitmapFormat4BitPalette:
+            palette_size = 16;
+            break;
+        default:
+            // Not a palette-based format, can't invert
+            return;
+    }
+    for (int i = 0; i < palette_size; i++) {
+        palette[i] = invert_dot_color(palette[i]);
+    }
+}
+
+// Load the dot stamps with the palette for the current dark mode setting
+void dots_load(bool dark_mode) {
+    dots_unload();
+    s_dot_sprites = gbitmap_create_with_resource(RESOURCE_ID_DOT_STAMPS);
+    if (!s_dot_sprites) {
+        LOG_ERROR("Failed to load dot stamps");
+        return;
+    }
+    if (dark_mode) {
+        invert_dot_palette(s_dot_sprites);
+    }
+}
+
+// Release the dot stamps
+void dots_unload(void) {
+    if (s_dot_sprites) {
+        gbitmap_destroy(s_dot_sprites);
+        s_dot_sprites = NULL;
+    }
+}
+
+static int min_int(int a, int b) { return a < b ? a : b; }
+static int max_int(int a, int b) { return a > b ? a : b; }
+
+// Blit the part of a dot frame that lands on the given screen rectangle
+static void blit_dot_part(GContext *ctx, DotKind kind, GPoint origin, int x0, int y0, int x1, int y1) {
+    if (x1 <= x0 || y1 <= y0) return;
+    INVALIDATE_COUNT_PAINTED(x1 - x0, y1 - y0);
+    // Point the sheet's bounds at the frame instead of allocating a sub-bitmap
+    gbitmap_set_bounds(s_dot_sprites, GRect(x0 - origin.x, kind * DOT_SIZE + y0 - origin.y,
+                                            x1 - x0, y1 - y0));
+    // Set here rather than once per dot so no other draw depends on call order
+    graphics_context_set_compositing_mode(ctx, GCompOpSet);
+    graphics_draw_bitmap_in_rect(ctx, s_dot_sprites, GRect(x0, y0, x1 - x0, y1 - y0));
+}
+
+// Blit a dot stamp centered on the given point, skipping any pixels that fall
+// inside the occluder (the time block draws over that area anyway)
+void dots_draw(GContext *ctx, DotKind kind, GPoint center, GRect occluder) {
+    if (!s_dot_sprites) return;
+    GPoint origin = GPoint(center.x - DOT_RADIUS, center.y - DOT_RADIUS);
+    int x0 = origin.x, y0 = origin.y;
+    int x1 = x0 + DOT_SIZE, y1 = y0 + DOT_SIZE;
+    int ox0 = occluder.origin.x, oy0 = occluder.origin.y;
+    int ox1 = ox0 + occluder.size.w, oy1 = oy0 + occluder.size.h;
+    // No overlap: draw the whole stamp
+    if (ox1 <= x0 || ox0 >= x1 || oy1 <= y0 || oy0 >= y1) {
+        blit_dot_part(ctx, kind, origin, x0, y0, x1, y1);
+        return;
+    }
+    // Partial overlap: draw up to four strips around the occluder
+    int band_y0 = max_int(y0, oy0);
+    int band_y1 = min_int(y1, oy1);
+    INVALIDATE_COUNT_AVOIDED(min_int(x1, ox1) - max_int(x0, ox0), band_y1 - band_y0);
+    blit_dot_part(ctx, kind, origin, x0, y0, x1, band_y0);          // Above
+    blit_dot_part(ctx, kind, origin, x0, band_y1, x1, y1);          // Below
+    blit_dot_part(ctx, kind, origin, x0, band_y0, min_int(x1, ox0), band_y1); // Left
+    blit_dot_part(ctx, kind, origin, max_int(x0, ox1), band_y0, x1, band_y1); // Right
+}
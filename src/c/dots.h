@@ -0,0 +1,21 @@
+#ifndef DOTS_H
+#define DOTS_H
+
+#include <pebble.h>
+
+// Dot kinds, in the same order as the frames in dots.png (see tools/glyphgen.py)
+typedef enum {
+    DOT_SECOND = 0,
+    DOT_HOUR_MINUTE
+} DotKind;
+
+// Dot stamp dimensions (DOT_SIZE is 8px on most platforms, see glyphs.auto.h)
+#include "glyphs.auto.h"
+#define DOT_RADIUS (DOT_SIZE / 2)
+
+// Function declarations
+void dots_load(bool dark_mode);
+void dots_unload(void);
+void dots_draw(GContext *ctx, DotKind kind, GPoint center, GRect occluder);
+
+#endif // DOTS_H
@@ -2,13 +2,27 @@
 #include "math.h"
 #include "widgets.h"
 #include "config.h"
+#include "dots.h"
+#include "layout.h"
+#include "font.h"
+#include "sweep.h"
+#include "power.h"
+#include "invalidate.h"
+#include "log.h"
+#include "../common/worker_protocol.h"
 
 static Window *s_main_window;
 static Layer *s_canvas_layer;
-static GBitmap *s_priority_sprites;
-static GBitmap *s_subpriority_sprites;
-static GBitmap *s_midpriority_sprites;
-static GBitmap *s_day_sprites;
+static Font s_priority_font;
+static Font s_subpriority_font;
+static Font s_midpriority_font;
+static Font s_day_font;
+static bool s_day_plan_valid = false; // Day letters need resolving before next draw
+
+// Rotating dot variables
+static int s_current_second = 0;
+static int s_current_minute = 0;
+static int s_current_hour = 0;
 
 // Debug mode variables
 static int s_debug_counter = 0;
@@ -16,6 +30,7 @@ static AppTimer *s_debug_timer = NULL;
 
 // Forward declarations
 static void debug_timer_callback(void *data);
+static void tick_handler(struct tm *tick_time, TimeUnits units_changed);
 
 // Persistent storage key
 #define SETTINGS_KEY 1
@@ -24,9 +39,29 @@ static void debug_timer_callback(void *data);
 #define MESSAGE_KEY_ShowSecondDot 10007
 #define MESSAGE_KEY_ShowHourMinuteDots 10008
 
+// Clay sends every setting in one message, so the inbox is sized for all of
+// them: keep SETTINGS_KEY_COUNT in step with messageKeys in package.json.
+// Toggles arrive as 4 byte integers, selects and inputs as short strings; the
+// longest is a step goal ("50000" plus terminator). src/js/index.js clamps the
+// step goal and rounds latitude and longitude to two decimals before sending
+// ("-122.42" plus terminator), and the headroom covers anything that slips by.
+#define SETTINGS_KEY_COUNT 24
+#define SETTINGS_VALUE_MAX_SIZE 6
+#define SETTINGS_LOCATION_KEY_COUNT 2
+#define SETTINGS_LOCATION_MAX_SIZE 8
+#define SETTINGS_TUPLE_HEADER_SIZE 7 // Key (4), type (1) and length (2)
+#define SETTINGS_INBOX_HEADROOM 64
+#define SETTINGS_INBOX_SIZE \
+    (1 + (SETTINGS_KEY_COUNT - SETTINGS_LOCATION_KEY_COUNT) * \
+             (SETTINGS_TUPLE_HEADER_SIZE + SETTINGS_VALUE_MAX_SIZE) + \
+     SETTINGS_LOCATION_KEY_COUNT * (SETTINGS_TUPLE_HEADER_SIZE + SETTINGS_LOCATION_MAX_SIZE) + \
+     SETTINGS_INBOX_HEADROOM)
+// The face never sends anything
+#define SETTINGS_OUTBOX_SIZE 0
+
 // External settings for widget system
 bool s_settings_dark_mode = false;
-bool s_settings_debug_logging = false;
+bool s_settings_use_24_hour_format = false;
 
 
 static Settings s_settings;
@@ -50,29 +85,250 @@ static void prv_load_settings()
 // Function to invert bitmap palette for dark mode
 static void invert_bitmap_palette(GBitmap *bitmap);
 
-// Function to reload sprites with correct palette for current dark mode setting
-static void prv_reload_sprites()
+// Load what the time needs (digits and dots) with the palette for the current
+// dark mode setting; with the cached widget bars, this is all the first frame
+// waits for
+static void prv_load_time_sprites()
 {
-    // Clean up existing sprites
-    if (s_priority_sprites) gbitmap_destroy(s_priority_sprites);
-    if (s_subpriority_sprites) gbitmap_destroy(s_subpriority_sprites);
-    if (s_midpriority_sprites) gbitmap_destroy(s_midpriority_sprites);
-    if (s_day_sprites) gbitmap_destroy(s_day_sprites);
-    // Reload all sprite sheets
-    s_priority_sprites = gbitmap_create_with_resource(RESOURCE_ID_PRIORITY_DIGIT);
-    s_subpriority_sprites = gbitmap_create_with_resource(
-                                RESOURCE_ID_SUBPRIORITY_DIGIT);
-    s_midpriority_sprites = gbitmap_create_with_resource(
-                                RESOURCE_ID_MIDPRIORITY_DIGIT);
-    s_day_sprites = gbitmap_create_with_resource(RESOURCE_ID_DAY_SPRITES);
+    // font_load releases any previous sheet
+    font_load(&s_priority_font, RESOURCE_ID_PRIORITY_DIGIT, FONT_LOOKUP_DIGITS,
+              GSize(PRIORITY_WIDTH, SPRITE_HEIGHT), SPRITES_PER_ROW, 10, DIGIT_SPACING);
+    font_load(&s_subpriority_font, RESOURCE_ID_SUBPRIORITY_DIGIT, FONT_LOOKUP_DIGITS,
+              GSize(SUBPRIORITY_WIDTH, SPRITE_HEIGHT), SPRITES_PER_ROW, 10, DIGIT_SPACING);
+    font_load(&s_midpriority_font, RESOURCE_ID_MIDPRIORITY_DIGIT, FONT_LOOKUP_DIGITS,
+              GSize(MIDPRIORITY_WIDTH, SPRITE_HEIGHT), SPRITES_PER_ROW, 10, DIGIT_SPACING);
     // Invert palette colors for dark mode if enabled
     if (s_settings.dark_mode)
     {
-        invert_bitmap_palette(s_priority_sprites);
-        invert_bitmap_palette(s_subpriority_sprites);
-        invert_bitmap_palette(s_midpriority_sprites);
-        invert_bitmap_palette(s_day_sprites);
+        invert_bitmap_palette(s_priority_font.sheet);
+        invert_bitmap_palette(s_subpriority_font.sheet);
+        invert_bitmap_palette(s_midpriority_font.sheet);
+    }
+    dots_load(s_settings.dark_mode);
+}
+
+// Load the day letters; until then the bottom row is left empty
+static void prv_load_day_sprites()
+{
+    font_load(&s_day_font, RESOURCE_ID_DAY_SPRITES, FONT_LOOKUP_DAY,
+              GSize(DAY_WIDTH, DAY_HEIGHT), DAY_SPRITES_PER_ROW, 14, 0);
+    if (s_settings.dark_mode)
+    {
+        invert_bitmap_palette(s_day_font.sheet);
+    }
+}
+
+// Function to reload sprites with correct palette for current dark mode setting
+static void prv_reload_sprites()
+{
+    prv_load_time_sprites();
+    prv_load_day_sprites();
+}
+
+// Power policy in force, re-chosen on settings and battery changes
+static PowerPolicy s_power_policy;
+static bool s_power_policy_applied = false;
+
+// Tap-to-wake burst of per-second updates
+static AppTimer *s_tap_burst_timer = NULL;
+static bool s_tap_subscribed = false;
+
+// Inside the night schedule or Quiet Time, re-checked on each minute tick
+static bool s_seconds_suspended = false;
+
+// Re-pick the power policy and apply it: tick granularity, sweep and sensors
+static void prv_apply_power_policy()
+{
+    if (!s_canvas_layer) return;
+    PowerContext context = {
+        .charge = battery_state_service_peek(),
+        .tap_burst_active = s_tap_burst_timer != NULL,
+        .seconds_suspended = s_seconds_suspended
+    };
+    PowerPolicy policy = power_policy_select(&s_settings, &context);
+    // Run the smooth sweep only while the policy allows it (a stopped sweep
+    // picks up a new frame rate when it restarts)
+    if (policy.smooth_sweep && !sweep_running())
+    {
+        sweep_start(s_settings.sweep_fps);
+    }
+    else if (!policy.smooth_sweep && sweep_running())
+    {
+        sweep_stop();
+        // No second ticks ran during the sweep, so the stepped dot starts
+        // from the clock rather than where it was before the sweep
+        s_current_second = time(NULL) % 60;
+    }
+    if (s_power_policy_applied && power_policy_equal(&policy, &s_power_policy)) return;
+    if (!s_power_policy_applied || policy.mode != s_power_policy.mode)
+    {
+        // Shown on the face by the colon, see canvas_update_proc
+        LOG_INFO("Power policy: %s", power_policy_name(policy.mode));
+        LOG_EVENT("Power policy: mode %ld", policy.mode, 0);
+    }
+    if (!s_power_policy_applied || policy.tick_units != s_power_policy.tick_units)
+    {
+        tick_timer_service_subscribe(policy.tick_units, tick_handler);
     }
+    widgets_set_live_sensor_updates(policy.live_sensor_updates);
+    s_power_policy = policy;
+    s_power_policy_applied = true;
+    invalidate_post(INVALIDATE_CONFIG);
+}
+
+// Re-check the night schedule and Quiet Time; true if the state flipped
+static bool prv_update_seconds_suspended(int hour)
+{
+    bool suspended = power_seconds_suspended(&s_settings, hour);
+    if (suspended == s_seconds_suspended) return false;
+    s_seconds_suspended = suspended;
+    LOG_INFO("Second updates %s", suspended ? "suspended" : "resumed");
+    LOG_EVENT("Second updates suspended: %ld", suspended, 0);
+    return true;
+}
+
+// Burst over, back to minute ticks
+static void prv_tap_burst_timer_callback(void *data)
+{
+    s_tap_burst_timer = NULL;
+    prv_apply_power_policy();
+}
+
+// Wrist flick or tap: run the second dot for a while
+static void prv_accel_tap_handler(AccelAxisType axis, int32_t direction)
+{
+    uint32_t burst_ms = (uint32_t)s_settings.tap_burst_seconds * 1000;
+    if (s_tap_burst_timer)
+    {
+        // Already bursting, just extend it
+        app_timer_reschedule(s_tap_burst_timer, burst_ms);
+        return;
+    }
+    s_tap_burst_timer = app_timer_register(burst_ms, prv_tap_burst_timer_callback, NULL);
+    // Show the right second straight away rather than after the first tick
+    s_current_second = time(NULL) % 60;
+    prv_apply_power_policy();
+}
+
+// Listen for taps only while tap-to-wake is on
+static void prv_update_tap_subscription()
+{
+    bool want_taps = s_canvas_layer && s_settings.tap_to_wake && s_settings.show_second_dot;
+    if (want_taps && !s_tap_subscribed)
+    {
+        accel_tap_service_subscribe(prv_accel_tap_handler);
+    }
+    else if (!want_taps && s_tap_subscribed)
+    {
+        accel_tap_service_unsubscribe();
+    }
+    s_tap_subscribed = want_taps;
+    if (!want_taps && s_tap_burst_timer)
+    {
+        app_timer_cancel(s_tap_burst_timer);
+        s_tap_burst_timer = NULL;
+    }
+}
+
+// Run the background worker only if the user opted in. Only one app's worker
+// can run at a time and launching ours over another one asks the user to
+// confirm, so the face never launches it on its own.
+static void prv_update_worker()
+{
+#if defined(PBL_HEALTH)
+    bool want_worker = s_settings.background_worker;
+#else
+    // The worker only counts steps
+    bool want_worker = false;
+#endif
+    if (!want_worker)
+    {
+        if (app_worker_is_running())
+        {
+            app_worker_kill();
+        }
+        return;
+    }
+    if (!app_worker_is_running())
+    {
+        // A cold worker pushes a snapshot itself once it is listening
+        app_worker_launch();
+        return;
+    }
+    AppWorkerMessage request = { 0 };
+    app_worker_send_message(WORKER_MSG_SNAPSHOT_REQUEST, &request);
+}
+
+// Battery level changed (forwarded by the widget system)
+static void prv_battery_listener(BatteryChargeState charge_state)
+{
+    prv_apply_power_policy();
+}
+
+// Degrees as typed on the phone ("51.5", "-0.12") to hundredths, rounded.
+// Anything empty, malformed or beyond +/-limit reads as no location.
+static int32_t prv_parse_degrees_e2(const char *text, int32_t limit)
+{
+    int32_t sign = 1;
+    if (*text == '-' || *text == '+')
+    {
+        sign = (*text == '-') ? -1 : 1;
+        text++;
+    }
+    if (!*text)
+    {
+        return SUN_NO_LOCATION;
+    }
+    int32_t whole = 0;
+    while (*text >= '0' && *text <= '9')
+    {
+        whole = whole * 10 + (*text++ - '0');
+        if (whole > limit)
+        {
+            return SUN_NO_LOCATION;
+        }
+    }
+    // Three decimals are kept so the last one can round
+    int32_t fraction = 0;
+    int digits = 0;
+    if (*text == '.' || *text == ',')
+    {
+        text++;
+        for (; *text >= '0' && *text <= '9'; text++)
+        {
+            if (digits < 3)
+            {
+                fraction = fraction * 10 + (*text - '0');
+                digits++;
+            }
+        }
+    }
+    if (*text)
+    {
+        return SUN_NO_LOCATION;
+    }
+    for (; digits < 3; digits++)
+    {
+        fraction *= 10;
+    }
+    int32_t value_e2 = whole * 100 + (fraction + 5) / 10;
+    if (value_e2 > limit * 100)
+    {
+        return SUN_NO_LOCATION;
+    }
+    return sign * value_e2;
+}
+
+// Latitude or longitude tuple: Clay sends the input's text, anything else is
+// taken as hundredths already
+static int32_t prv_read_degrees_e2(const Tuple *tuple, int32_t limit)
+{
+    if (tuple->type == TUPLE_CSTRING)
+    {
+        return prv_parse_degrees_e2(tuple->value->cstring, limit);
+    }
+    int32_t value_e2 = tuple->value->int32;
+    return (value_e2 >= -limit * 100 && value_e2 <= limit * 100) ? value_e2 : SUN_NO_LOCATION;
 }
 
 // AppMessage inbox received handler
@@ -91,60 +347,180 @@ static void prv_inbox_received_handler(DictionaryIterator *iter, void *context)
     if (use_24_hour_format_t)
     {
         s_settings.use_24_hour_format = use_24_hour_format_t->value->int32 == 1;
+        s_settings_use_24_hour_format = s_settings.use_24_hour_format;
     }
     Tuple *use_two_letter_day_t = dict_find(iter, MESSAGE_KEY_UseTwoLetterDay);
     if (use_two_letter_day_t)
     {
         s_settings.use_two_letter_day = use_two_letter_day_t->value->int32 == 1;
+        // Day letters change shape, rebuild the glyph plan on next draw
+        s_day_plan_valid = false;
     }
     
     // Handle new dot visibility settings
     Tuple *show_second_dot_t = dict_find(iter, MESSAGE_KEY_ShowSecondDot);
     if (show_second_dot_t) {
-        if (s_settings.debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "ShowSecondDot received - type: %d", show_second_dot_t->type);
-        }
+        LOG_DEBUG("ShowSecondDot received - type: %d", show_second_dot_t->type);
         bool new_show_second_dot;
         if (show_second_dot_t->type == TUPLE_CSTRING) {
             // Convert string to boolean
             const char *show_second_dot_str = show_second_dot_t->value->cstring;
-            if (s_settings.debug_logging) {
-                APP_LOG(APP_LOG_LEVEL_INFO, "ShowSecondDot as string: '%s'", show_second_dot_str);
-            }
+            LOG_DEBUG("ShowSecondDot as string: '%s'", show_second_dot_str);
             new_show_second_dot = (strcmp(show_second_dot_str, "true") == 0 || strcmp(show_second_dot_str, "1") == 0);
         } else {
             // Use integer value directly
             new_show_second_dot = show_second_dot_t->value->int32 == 1;
         }
-        if (s_settings.debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "ShowSecondDot setting changed: %d -> %d", s_settings.show_second_dot, new_show_second_dot);
-        }
+        LOG_DEBUG("ShowSecondDot setting changed: %d -> %d", s_settings.show_second_dot, new_show_second_dot);
         s_settings.show_second_dot = new_show_second_dot;
     }
     
     Tuple *show_hour_minute_dots_t = dict_find(iter, MESSAGE_KEY_ShowHourMinuteDots);
     if (show_hour_minute_dots_t) {
-        if (s_settings.debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "ShowHourMinuteDots received - type: %d", show_hour_minute_dots_t->type);
-        }
+        LOG_DEBUG("ShowHourMinuteDots received - type: %d", show_hour_minute_dots_t->type);
         bool new_show_hour_minute_dots;
         if (show_hour_minute_dots_t->type == TUPLE_CSTRING) {
             // Convert string to boolean
             const char *show_hour_minute_dots_str = show_hour_minute_dots_t->value->cstring;
-            if (s_settings.debug_logging) {
-                APP_LOG(APP_LOG_LEVEL_INFO, "ShowHourMinuteDots as string: '%s'", show_hour_minute_dots_str);
-            }
+            LOG_DEBUG("ShowHourMinuteDots as string: '%s'", show_hour_minute_dots_str);
             new_show_hour_minute_dots = (strcmp(show_hour_minute_dots_str, "true") == 0 || strcmp(show_hour_minute_dots_str, "1") == 0);
         } else {
             // Use integer value directly
             new_show_hour_minute_dots = show_hour_minute_dots_t->value->int32 == 1;
         }
-        if (s_settings.debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "ShowHourMinuteDots setting changed: %d -> %d", s_settings.show_hour_minute_dots, new_show_hour_minute_dots);
-        }
+        LOG_DEBUG("ShowHourMinuteDots setting changed: %d -> %d", s_settings.show_hour_minute_dots, new_show_hour_minute_dots);
         s_settings.show_hour_minute_dots = new_show_hour_minute_dots;
     }
     
+    // Handle smooth sweep configuration
+    Tuple *smooth_sweep_t = dict_find(iter, MESSAGE_KEY_SmoothSweep);
+    if (smooth_sweep_t) {
+        if (smooth_sweep_t->type == TUPLE_CSTRING) {
+            const char *smooth_sweep_str = smooth_sweep_t->value->cstring;
+            s_settings.smooth_sweep = (strcmp(smooth_sweep_str, "true") == 0 || strcmp(smooth_sweep_str, "1") == 0);
+        } else {
+            s_settings.smooth_sweep = smooth_sweep_t->value->int32 == 1;
+        }
+    }
+    Tuple *sweep_fps_t = dict_find(iter, MESSAGE_KEY_SweepFps);
+    if (sweep_fps_t) {
+        // Clay selects arrive as strings
+        int32_t sweep_fps = (sweep_fps_t->type == TUPLE_CSTRING) ?
+            atoi(sweep_fps_t->value->cstring) : sweep_fps_t->value->int32;
+        if (sweep_fps < SWEEP_FPS_MIN || sweep_fps > SWEEP_FPS_MAX) {
+            sweep_fps = DEFAULT_SWEEP_FPS;
+        }
+        if (sweep_fps != s_settings.sweep_fps) {
+            // Restarted at the new rate when the power policy is re-applied
+            sweep_stop();
+        }
+        s_settings.sweep_fps = sweep_fps;
+    }
+    Tuple *power_saver_threshold_t = dict_find(iter, MESSAGE_KEY_PowerSaverThreshold);
+    if (power_saver_threshold_t) {
+        int32_t threshold = (power_saver_threshold_t->type == TUPLE_CSTRING) ?
+            atoi(power_saver_threshold_t->value->cstring) : power_saver_threshold_t->value->int32;
+        if (threshold < 0 || threshold > POWER_SAVER_THRESHOLD_MAX) {
+            threshold = DEFAULT_POWER_SAVER_THRESHOLD;
+        }
+        s_settings.power_saver_threshold = threshold;
+    }
+    Tuple *tap_to_wake_t = dict_find(iter, MESSAGE_KEY_TapToWake);
+    if (tap_to_wake_t) {
+        if (tap_to_wake_t->type == TUPLE_CSTRING) {
+            const char *tap_to_wake_str = tap_to_wake_t->value->cstring;
+            s_settings.tap_to_wake = (strcmp(tap_to_wake_str, "true") == 0 || strcmp(tap_to_wake_str, "1") == 0);
+        } else {
+            s_settings.tap_to_wake = tap_to_wake_t->value->int32 == 1;
+        }
+    }
+    Tuple *tap_burst_seconds_t = dict_find(iter, MESSAGE_KEY_TapBurstSeconds);
+    if (tap_burst_seconds_t) {
+        int32_t burst = (tap_burst_seconds_t->type == TUPLE_CSTRING) ?
+            atoi(tap_burst_seconds_t->value->cstring) : tap_burst_seconds_t->value->int32;
+        if (burst < TAP_BURST_SECONDS_MIN || burst > TAP_BURST_SECONDS_MAX) {
+            burst = DEFAULT_TAP_BURST_SECONDS;
+        }
+        s_settings.tap_burst_seconds = burst;
+    }
+    Tuple *night_schedule_t = dict_find(iter, MESSAGE_KEY_NightSchedule);
+    if (night_schedule_t) {
+        if (night_schedule_t->type == TUPLE_CSTRING) {
+            const char *night_schedule_str = night_schedule_t->value->cstring;
+            s_settings.night_schedule = (strcmp(night_schedule_str, "true") == 0 || strcmp(night_schedule_str, "1") == 0);
+        } else {
+            s_settings.night_schedule = night_schedule_t->value->int32 == 1;
+        }
+    }
+    Tuple *night_start_hour_t = dict_find(iter, MESSAGE_KEY_NightStartHour);
+    if (night_start_hour_t) {
+        int32_t hour = (night_start_hour_t->type == TUPLE_CSTRING) ?
+            atoi(night_start_hour_t->value->cstring) : night_start_hour_t->value->int32;
+        s_settings.night_start_hour = (hour >= 0 && hour < 24) ? hour : DEFAULT_NIGHT_START_HOUR;
+    }
+    Tuple *night_end_hour_t = dict_find(iter, MESSAGE_KEY_NightEndHour);
+    if (night_end_hour_t) {
+        int32_t hour = (night_end_hour_t->type == TUPLE_CSTRING) ?
+            atoi(night_end_hour_t->value->cstring) : night_end_hour_t->value->int32;
+        s_settings.night_end_hour = (hour >= 0 && hour < 24) ? hour : DEFAULT_NIGHT_END_HOUR;
+    }
+    Tuple *follow_quiet_time_t = dict_find(iter, MESSAGE_KEY_FollowQuietTime);
+    if (follow_quiet_time_t) {
+        if (follow_quiet_time_t->type == TUPLE_CSTRING) {
+            const char *follow_quiet_time_str = follow_quiet_time_t->value->cstring;
+            s_settings.follow_quiet_time = (strcmp(follow_quiet_time_str, "true") == 0 || strcmp(follow_quiet_time_str, "1") == 0);
+        } else {
+            s_settings.follow_quiet_time = follow_quiet_time_t->value->int32 == 1;
+        }
+    }
+    Tuple *heart_rate_period_t = dict_find(iter, MESSAGE_KEY_HeartRatePeriod);
+    if (heart_rate_period_t) {
+        int32_t period = (heart_rate_period_t->type == TUPLE_CSTRING) ?
+            atoi(heart_rate_period_t->value->cstring) : heart_rate_period_t->value->int32;
+        s_settings.heart_rate_period = period >= 0 ? period : DEFAULT_HEART_RATE_PERIOD;
+        widgets_set_heart_rate_period(s_settings.heart_rate_period);
+    }
+    Tuple *latitude_t = dict_find(iter, MESSAGE_KEY_Latitude);
+    if (latitude_t) {
+        s_settings.latitude_e2 = prv_read_degrees_e2(latitude_t, 90);
+    }
+    Tuple *longitude_t = dict_find(iter, MESSAGE_KEY_Longitude);
+    if (longitude_t) {
+        s_settings.longitude_e2 = prv_read_degrees_e2(longitude_t, 180);
+    }
+    if (latitude_t || longitude_t) {
+        widgets_set_location(s_settings.latitude_e2, s_settings.longitude_e2);
+    }
+    Tuple *background_worker_t = dict_find(iter, MESSAGE_KEY_BackgroundWorker);
+    if (background_worker_t) {
+        bool background_worker = (background_worker_t->type == TUPLE_CSTRING) ?
+            (strcmp(background_worker_t->value->cstring, "true") == 0 || strcmp(background_worker_t->value->cstring, "1") == 0) :
+            background_worker_t->value->int32 == 1;
+        if (background_worker != s_settings.background_worker) {
+            s_settings.background_worker = background_worker;
+            prv_update_worker();
+        }
+    }
+    Tuple *dump_log_t = dict_find(iter, MESSAGE_KEY_DumpLog);
+    if (dump_log_t) {
+        // Not a setting: write the event ring to the app log now
+        bool dump_log = (dump_log_t->type == TUPLE_CSTRING) ?
+            (strcmp(dump_log_t->value->cstring, "true") == 0 || strcmp(dump_log_t->value->cstring, "1") == 0) :
+            dump_log_t->value->int32 == 1;
+        if (dump_log) {
+            invalidate_log_stats();
+            log_dump();
+        }
+    }
+    Tuple *second_tz_offset_t = dict_find(iter, MESSAGE_KEY_SecondTimezoneOffset);
+    if (second_tz_offset_t) {
+        int32_t offset = (second_tz_offset_t->type == TUPLE_CSTRING) ?
+            atoi(second_tz_offset_t->value->cstring) : second_tz_offset_t->value->int32;
+        // UTC-12:00 to UTC+14:00
+        s_settings.second_tz_offset = (offset >= -12 * 60 && offset <= 14 * 60) ? offset : DEFAULT_SECOND_TZ_OFFSET;
+        widgets_set_second_tz_offset(s_settings.second_tz_offset);
+    }
+    
     // Handle step goal configuration
     Tuple *step_goal_t = dict_find(iter, MESSAGE_KEY_StepGoal);
     if (step_goal_t) {
@@ -154,32 +530,24 @@ static void prv_inbox_received_handler(DictionaryIterator *iter, void *context)
             // Convert string to integer with better error handling
             const char *step_goal_str = step_goal_t->value->cstring;
             step_goal_value = atoi(step_goal_str);
-            if (s_settings.debug_logging) {
-                APP_LOG(APP_LOG_LEVEL_INFO, "Received step_goal as string: '%s' -> %ld", step_goal_str, (long)step_goal_value);
-            }
+            LOG_DEBUG("Received step_goal as string: '%s' -> %ld", step_goal_str, (long)step_goal_value);
             
             // Validate the conversion
             if (step_goal_value <= 0) {
-                if (s_settings.debug_logging) {
-                    APP_LOG(APP_LOG_LEVEL_WARNING, "Invalid step goal conversion, using default: %ld", (long)step_goal_value);
-                }
+                LOG_WARNING("Invalid step goal conversion, using default: %ld", (long)step_goal_value);
                 step_goal_value = 10000; // Default step goal
             }
         } else {
             // Use integer value directly
             step_goal_value = step_goal_t->value->int32;
-            if (s_settings.debug_logging) {
-                APP_LOG(APP_LOG_LEVEL_INFO, "Received step_goal as int: %ld (type: %d)", (long)step_goal_value, step_goal_t->type);
-            }
+            LOG_DEBUG("Received step_goal as int: %ld (type: %d)", (long)step_goal_value, step_goal_t->type);
         }
         // Save step goal to settings
         s_settings.step_goal = step_goal_value;
         // Update widget system with new step goal
         widgets_set_step_goal(step_goal_value);
     } else {
-        if (s_settings.debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "No step_goal received, using saved value: %d", s_settings.step_goal);
-        }
+        LOG_DEBUG("No step_goal received, using saved value: %d", s_settings.step_goal);
     }
     
     // Handle widget configuration
@@ -194,14 +562,10 @@ static void prv_inbox_received_handler(DictionaryIterator *iter, void *context)
             // Use integer value directly
             widget_value = top_left_widget_t->value->int32;
         }
-        if (s_settings.debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "Received top_left_widget: %ld (type: %d)", (long)widget_value, top_left_widget_t->type);
-        }
+        LOG_DEBUG("Received top_left_widget: %ld (type: %d)", (long)widget_value, top_left_widget_t->type);
         s_settings.widget_config.top_left_widget = (WidgetType)widget_value;
     } else {
-        if (s_settings.debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "No top_left_widget received, using default");
-        }
+        LOG_DEBUG("No top_left_widget received, using default");
         s_settings.widget_config.top_left_widget = WIDGET_MONTH_DATE;
     }
     
@@ -216,14 +580,10 @@ static void prv_inbox_received_handler(DictionaryIterator *iter, void *context)
             // Use integer value directly
             widget_value = top_right_widget_t->value->int32;
         }
-        if (s_settings.debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "Received top_right_widget: %ld (type: %d)", (long)widget_value, top_right_widget_t->type);
-        }
+        LOG_DEBUG("Received top_right_widget: %ld (type: %d)", (long)widget_value, top_right_widget_t->type);
         s_settings.widget_config.top_right_widget = (WidgetType)widget_value;
     } else {
-        if (s_settings.debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "No top_right_widget received, using default");
-        }
+        LOG_DEBUG("No top_right_widget received, using default");
         s_settings.widget_config.top_right_widget = WIDGET_DAY_DATE;
     }
     
@@ -241,8 +601,28 @@ static void prv_inbox_received_handler(DictionaryIterator *iter, void *context)
         prv_reload_sprites();
         widgets_reload_sprites();
     }
-    // Force redraw to apply new settings
-    layer_mark_dirty(s_canvas_layer);
+    // Second dot, sweep, tap, schedule or battery threshold settings may have changed
+    time_t now = time(NULL);
+    prv_update_seconds_suspended(localtime(&now)->tm_hour);
+    prv_update_tap_subscription();
+    prv_apply_power_policy();
+    // Redraw to apply new settings
+    invalidate_post(INVALIDATE_CONFIG);
+}
+
+// A settings message that didn't fit or arrived while busy
+static void prv_inbox_dropped_handler(AppMessageResult reason, void *context)
+{
+    if (reason == APP_MSG_BUFFER_OVERFLOW)
+    {
+        // Every setting in the message is lost, not just the oversized one
+        LOG_ERROR_LIMITED("Settings message overflowed the %d byte inbox", SETTINGS_INBOX_SIZE);
+    }
+    else
+    {
+        LOG_WARNING("Settings message dropped: %d", (int)reason);
+    }
+    LOG_EVENT("Settings message dropped: %ld", reason, 0);
 }
 
 // Debug mode timer callback
@@ -252,7 +632,7 @@ static void debug_timer_callback(void *data) {
         if (s_debug_counter > 100) { // Reset after cycling through all combinations
             s_debug_counter = 0;
         }
-        layer_mark_dirty(s_canvas_layer);
+        invalidate_post(INVALIDATE_DEBUG);
         // Schedule next debug update (500ms interval for quick cycling)
         s_debug_timer = app_timer_register(500, debug_timer_callback, NULL);
     } else {
@@ -260,10 +640,189 @@ static void debug_timer_callback(void *data) {
     }
 }
 
-// Rotating dot variables
-static int s_current_second = 0;
-static int s_current_minute = 0;
-static int s_current_hour = 0;
+// Face geometry in use this frame: one of the two precomputed layouts, or a
+// blend of them while Timeline Quick View animates
+static FaceLayout s_face_layout;
+
+// Full screen and Timeline Quick View ("peek") layouts, both precomputed so
+// the unobstructed area animation only blends between them
+#define PEEK_HEIGHT 51 // Quick View height, used until the system reports the real one
+static FaceLayout s_full_layout;
+static FaceLayout s_peek_layout;
+static const FaceLayout *s_rest_layout = &s_full_layout; // Layout in use outside animations
+static FaceLayout s_anim_from_layout;
+static const FaceLayout *s_anim_to_layout = NULL;
+static AnimationProgress s_anim_progress;
+
+// Everything placed for the displayed time on one layout
+typedef struct
+{
+    TimeLayout time;
+    // Which second positions are visible around the time block
+    uint64_t second_visible;
+    // Hour dot position, for the current hour and minute
+    GPoint hour_dot;
+} FacePlacement;
+
+// Placements for the full and peek layouts, recomputed only when the time
+// changes, and the one in use this frame (a copy of one of them, or a blend)
+static FacePlacement s_full_placement;
+static FacePlacement s_peek_placement;
+static FacePlacement s_anim_from_placement;
+static FacePlacement s_placement = { .second_visible = ~(uint64_t)0 };
+static bool s_placement_valid = false;
+
+// Placement cached for a precomputed layout
+static FacePlacement *prv_placement_for(const FaceLayout *layout)
+{
+    return (layout == &s_peek_layout) ? &s_peek_placement : &s_full_placement;
+}
+
+// Time block and second visibility for one layout
+static void prv_place_time(FacePlacement *placement, const FaceLayout *layout, int hour, int minute)
+{
+    layout_compute_time(&placement->time, layout->bounds, hour, minute);
+    placement->second_visible = layout_second_visibility(&placement->time, layout->ring, DOT_RADIUS);
+}
+
+// Hour dot for one layout
+// 12 hours = 360 degrees, plus minutes contribute to hour position
+static void prv_place_hour_dot(FacePlacement *placement, const FaceLayout *layout)
+{
+    int display_hour = s_current_hour % 12;
+    placement->hour_dot = layout_ring_point(layout, display_hour * 60 + s_current_minute, 12 * 60);
+}
+
+// Blend the animation's start and target with integer math only
+static void prv_blend_placement(AnimationProgress progress)
+{
+    const FacePlacement *to = prv_placement_for(s_anim_to_layout);
+    layout_interpolate_face(&s_face_layout, &s_anim_from_layout, s_anim_to_layout,
+                            progress, ANIMATION_NORMALIZED_MAX);
+    layout_interpolate_time(&s_placement.time, &s_anim_from_placement.time, &to->time,
+                            progress, ANIMATION_NORMALIZED_MAX);
+    // Positions move in straight lines, so a dot hidden at both ends stays
+    // hidden in between
+    s_placement.second_visible = s_anim_from_placement.second_visible | to->second_visible;
+    s_placement.hour_dot = layout_interpolate_point(s_anim_from_placement.hour_dot, to->hour_dot,
+                                                    progress, ANIMATION_NORMALIZED_MAX);
+}
+
+// Bring the placement in use up to date after the cached ones changed
+static void prv_refresh_placement(void)
+{
+    if (s_anim_to_layout)
+    {
+        prv_blend_placement(s_anim_progress);
+    }
+    else
+    {
+        s_placement = *prv_placement_for(s_rest_layout);
+    }
+}
+
+// Recompute the time block (and everything derived from it) if the displayed time changed
+static void prv_update_time_layout(int hour, int minute)
+{
+    if (s_placement_valid && s_placement.time.hour == hour && s_placement.time.minute == minute)
+    {
+        return;
+    }
+    prv_place_time(&s_full_placement, &s_full_layout, hour, minute);
+    prv_place_time(&s_peek_placement, &s_peek_layout, hour, minute);
+    if (s_anim_to_layout)
+    {
+        // Mid-animation: the starting point shows the new time too
+        prv_place_time(&s_anim_from_placement, &s_anim_from_layout, hour, minute);
+    }
+    s_placement_valid = true;
+    prv_refresh_placement();
+}
+
+// Place the hour dot around the ring on both layouts
+static void prv_update_hour_dot(void)
+{
+    prv_place_hour_dot(&s_full_placement, &s_full_layout);
+    prv_place_hour_dot(&s_peek_placement, &s_peek_layout);
+    if (s_anim_to_layout)
+    {
+        prv_place_hour_dot(&s_anim_from_placement, &s_anim_from_layout);
+    }
+    prv_refresh_placement();
+}
+
+// Derive all geometry from the layer bounds; nothing below this is per-frame
+static void prv_update_face_layout(GRect bounds, GRect unobstructed_bounds)
+{
+    layout_compute_face(&s_full_layout, bounds);
+    GRect peek_bounds = bounds;
+    if (grect_equal(&unobstructed_bounds, &bounds))
+    {
+        peek_bounds.size.h -= PEEK_HEIGHT;
+    }
+    else
+    {
+        peek_bounds = unobstructed_bounds;
+    }
+    layout_compute_face(&s_peek_layout, peek_bounds);
+    s_rest_layout = grect_equal(&unobstructed_bounds, &bounds) ? &s_full_layout : &s_peek_layout;
+    s_face_layout = *s_rest_layout;
+    // Placements follow on the next draw
+    s_placement_valid = false;
+}
+
+// True if a second dot at this position shows any pixels
+static bool prv_second_visible(int second)
+{
+    return (s_placement.second_visible >> (second % RING_POSITIONS)) & 1;
+}
+
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+// Quick View is about to slide in or out: start from what is on screen now
+// and head for the precomputed target layout and placement
+static void prv_unobstructed_will_change(GRect final_unobstructed_screen_area, void *context)
+{
+    s_anim_from_layout = s_face_layout;
+    s_anim_from_placement = s_placement;
+    s_anim_progress = 0;
+    if (grect_equal(&final_unobstructed_screen_area, &s_full_layout.bounds))
+    {
+        s_anim_to_layout = &s_full_layout;
+    }
+    else
+    {
+        // Only recompute if the system's obstruction differs from our guess
+        if (!grect_equal(&final_unobstructed_screen_area, &s_peek_layout.bounds))
+        {
+            layout_compute_face(&s_peek_layout, final_unobstructed_screen_area);
+            prv_place_time(&s_peek_placement, &s_peek_layout,
+                           s_full_placement.time.hour, s_full_placement.time.minute);
+            prv_place_hour_dot(&s_peek_placement, &s_peek_layout);
+        }
+        s_anim_to_layout = &s_peek_layout;
+    }
+}
+
+// Each animation frame only blends positions; nothing is recomputed
+static void prv_unobstructed_change(AnimationProgress progress, void *context)
+{
+    if (!s_anim_to_layout) return;
+    s_anim_progress = progress;
+    prv_blend_placement(progress);
+    invalidate_post(INVALIDATE_LAYOUT);
+}
+
+// Land exactly on the target layout
+static void prv_unobstructed_did_change(void *context)
+{
+    if (!s_anim_to_layout) return;
+    s_rest_layout = s_anim_to_layout;
+    s_anim_to_layout = NULL;
+    s_face_layout = *s_rest_layout;
+    prv_refresh_placement();
+    invalidate_post(INVALIDATE_LAYOUT);
+}
+#endif
 
 // Function to invert bitmap palette for dark mode
 static void invert_bitmap_palette(GBitmap *bitmap)
@@ -303,211 +862,96 @@ static void invert_bitmap_palette(GBitmap *bitmap)
     }
 }
 
-// Sprite sheet dimensions
-#define PRIORITY_WIDTH 40
-#define SUBPRIORITY_WIDTH 27
-#define MIDPRIORITY_WIDTH 34
-#define SPRITE_HEIGHT 18
-#define SPRITES_PER_ROW 3
-#define SPRITES_PER_COLUMN 4
-
-// Day sprite dimensions (day.png - 4x4 grid, 20x14 sprites)
-#define DAY_WIDTH 20
-#define DAY_HEIGHT 14
-#define DAY_SPRITES_PER_ROW 4
 
-// Date sprite dimensions (date.png - 3x4 grid, 20x14 sprites)
-#define DATE_WIDTH 20
-#define DATE_HEIGHT 14
-#define DATE_SPRITES_PER_ROW 3
+// Bottom row day letters, resolved once per day instead of once per frame
+#define DAY_PLAN_MAX_GLYPHS 3
+typedef struct
+{
+    int day_of_week;
+    bool two_letter;
+    int count;
+    int glyph[DAY_PLAN_MAX_GLYPHS]; // Glyph indices in the day font
+    DaySlot slot[DAY_PLAN_MAX_GLYPHS]; // Positions come from the layout in use
+} DayGlyphPlan;
 
+static DayGlyphPlan s_day_plan;
 
-// Function to draw a day character (letters from day.png)
-static void draw_day_char(GContext *ctx, char character, int x, int y)
+// Resolve the day abbreviation into glyph indices and letter slots
+static void prv_build_day_plan(int day_of_week, bool two_letter)
 {
-    // Validate sprite sheet exists
-    if (!s_day_sprites)
+    static const char *const s_two_letter_days[] = { "SU", "MO", "TU", "WE", "TH", "FR", "SA" };
+    static const char *const s_three_letter_days[] = { "SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT" };
+    s_day_plan.day_of_week = day_of_week;
+    s_day_plan.two_letter = two_letter;
+    s_day_plan.count = 0;
+    s_day_plan_valid = true;
+    const char *day_abbrev;
+    if (day_of_week < 0 || day_of_week > 6)
     {
-        APP_LOG(APP_LOG_LEVEL_ERROR, "Day sprite sheet is NULL");
-        return;
+        day_abbrev = two_letter ? "ER" : "ERR";
     }
-    // Validate sprite sheet bounds
-    GSize sprite_sheet_size = gbitmap_get_bounds(s_day_sprites).size;
-    if (sprite_sheet_size.w <= 0 || sprite_sheet_size.h <= 0)
+    else
     {
-        APP_LOG(APP_LOG_LEVEL_ERROR, "Invalid day sprite sheet dimensions: %dx%d",
-                sprite_sheet_size.w, sprite_sheet_size.h);
-        return;
+        day_abbrev = two_letter ? s_two_letter_days[day_of_week] : s_three_letter_days[day_of_week];
     }
-    // Map character to sprite position in the 4x4 grid
-    // Layout: A,D,E,F,H,I,M,N,O,R,S,T,U,W
-    int sprite_index = -1;
-    switch (character)
-    {
-        case 'A': sprite_index = 0; break;
-        case 'D': sprite_index = 1; break;
-        case 'E': sprite_index = 2; break;
-        case 'F': sprite_index = 3; break;
-        case 'H': sprite_index = 4; break;
-        case 'I': sprite_index = 5; break;
-        case 'M': sprite_index = 6; break;
-        case 'N': sprite_index = 7; break;
-        case 'O': sprite_index = 8; break;
-        case 'R': sprite_index = 9; break;
-        case 'S': sprite_index = 10; break;
-        case 'T': sprite_index = 11; break;
-        case 'U': sprite_index = 12; break;
-        case 'W': sprite_index = 13; break;
-        default:
-            APP_LOG(APP_LOG_LEVEL_ERROR, "Unknown day character: %c", character);
-            return;
-    }
-    // Calculate sprite position in the spritesheet
-    int sprite_row = sprite_index / DAY_SPRITES_PER_ROW;
-    int sprite_col = sprite_index % DAY_SPRITES_PER_ROW;
-    // Validate sprite position is within bounds
-    int max_col = sprite_sheet_size.w / DAY_WIDTH;
-    int max_row = sprite_sheet_size.h / DAY_HEIGHT;
-    if (sprite_col >= max_col || sprite_row >= max_row)
-    {
-        APP_LOG(APP_LOG_LEVEL_ERROR,
-                "Day sprite position out of bounds: char=%c, row=%d/%d, col=%d/%d",
-                character, sprite_row, max_row, sprite_col, max_col);
-        return;
-    }
-    // Calculate source rectangle in the spritesheet
-    GRect source_rect = GRect(
-                            sprite_col * DAY_WIDTH,
-                            sprite_row * DAY_HEIGHT,
-                            DAY_WIDTH,
-                            DAY_HEIGHT
-                        );
-    // Calculate destination position
-    GRect dest_rect = GRect(x, y, DAY_WIDTH, DAY_HEIGHT);
-    // Set compositing mode for transparency
-    graphics_context_set_compositing_mode(ctx, GCompOpSet);
-    // Create a sub-bitmap for the specific sprite
-    GBitmap *char_bitmap = gbitmap_create_as_sub_bitmap(s_day_sprites, source_rect);
-    if (!char_bitmap)
-    {
-        APP_LOG(APP_LOG_LEVEL_ERROR, "Failed to create sub-bitmap for day character %c",
-                character);
-        return;
+    // First letter in bottom left, last letter in bottom right and (three-letter only)
+    // middle letter in bottom middle
+    const DaySlot slots[DAY_PLAN_MAX_GLYPHS] = {
+        DAY_SLOT_LEFT,
+        two_letter ? DAY_SLOT_RIGHT : DAY_SLOT_MIDDLE,
+        DAY_SLOT_RIGHT
+    };
+    for (int i = 0; day_abbrev[i] && i < DAY_PLAN_MAX_GLYPHS; i++)
+    {
+        int glyph = font_glyph_index(&s_day_font, day_abbrev[i]);
+        if (glyph < 0)
+        {
+            LOG_ERROR_LIMITED("Unknown day character: %c", day_abbrev[i]);
+            continue;
+        }
+        s_day_plan.glyph[s_day_plan.count] = glyph;
+        s_day_plan.slot[s_day_plan.count] = slots[i];
+        s_day_plan.count++;
     }
-    // Draw the sprite
-    graphics_draw_bitmap_in_rect(ctx, char_bitmap, dest_rect);
-    // Clean up the sub-bitmap
-    gbitmap_destroy(char_bitmap);
 }
 
-
-
-
-// Digit types for width selection
-typedef enum
+// Draw the resolved day letters
+static void draw_day_plan(GContext *ctx, const FaceLayout *layout)
 {
-    DIGIT_PRIORITY,
-    DIGIT_SUBPRIORITY,
-    DIGIT_MIDPRIORITY
-} DigitType;
+    for (int i = 0; i < s_day_plan.count; i++)
+    {
+        GPoint position = layout->day_slot[s_day_plan.slot[i]];
+        draw_glyph(ctx, &s_day_font, s_day_plan.glyph[i], position.x, position.y);
+    }
+}
 
-// Helper function to get digit width based on type
-static int get_digit_width(DigitType type)
+// Font for a digit type
+static const Font *prv_digit_font(DigitType type)
 {
     switch (type)
     {
         case DIGIT_PRIORITY:
-            return PRIORITY_WIDTH;
-        case DIGIT_SUBPRIORITY:
-            return SUBPRIORITY_WIDTH;
+            return &s_priority_font;
         case DIGIT_MIDPRIORITY:
-            return MIDPRIORITY_WIDTH;
+            return &s_midpriority_font;
+        case DIGIT_SUBPRIORITY:
         default:
-            return SUBPRIORITY_WIDTH; // Default fallback
+            return &s_subpriority_font;
     }
 }
 
-// Function to draw a digit with specified type
-static void draw_digit(GContext *ctx, int digit, DigitType type, int x, int y)
+// One colon square, solid or as a one pixel outline
+static void prv_draw_colon_square(GContext *ctx, GPoint origin, bool hollow)
 {
-    GBitmap *sprite_sheet = NULL;
-    int sprite_width = 0;
-    // Select the appropriate sprite sheet and width
-    switch (type)
+    GRect square = GRect(origin.x, origin.y, COLON_DOT_SIZE, COLON_DOT_SIZE);
+    if (hollow)
     {
-        case DIGIT_PRIORITY:
-            sprite_sheet = s_priority_sprites;
-            sprite_width = PRIORITY_WIDTH;
-            break;
-        case DIGIT_SUBPRIORITY:
-            sprite_sheet = s_subpriority_sprites;
-            sprite_width = SUBPRIORITY_WIDTH;
-            break;
-        case DIGIT_MIDPRIORITY:
-            sprite_sheet = s_midpriority_sprites;
-            sprite_width = MIDPRIORITY_WIDTH;
-            break;
-    }
-    // Validate sprite sheet exists
-    if (!sprite_sheet)
-    {
-        APP_LOG(APP_LOG_LEVEL_ERROR, "Sprite sheet is NULL for digit type: %d", type);
-        return;
-    }
-    // Validate sprite sheet bounds
-    GSize sprite_sheet_size = gbitmap_get_bounds(sprite_sheet).size;
-    if (sprite_sheet_size.w <= 0 || sprite_sheet_size.h <= 0)
-    {
-        APP_LOG(APP_LOG_LEVEL_ERROR, "Invalid sprite sheet dimensions: %dx%d",
-                sprite_sheet_size.w, sprite_sheet_size.h);
-        return;
-    }
-    // Calculate sprite position in the spritesheet
-    // Handle digit 0 specially (it's in row 3, column 0)
-    int sprite_row, sprite_col;
-    if (digit == 0)
-    {
-        sprite_row = 3;
-        sprite_col = 0;
+        graphics_draw_rect(ctx, square);
     }
     else
     {
-        sprite_row = (digit - 1) / SPRITES_PER_ROW;
-        sprite_col = (digit - 1) % SPRITES_PER_ROW;
-    }
-    // Validate sprite position is within bounds
-    int max_col = sprite_sheet_size.w / sprite_width;
-    int max_row = sprite_sheet_size.h / SPRITE_HEIGHT;
-    if (sprite_col >= max_col || sprite_row >= max_row)
-    {
-        APP_LOG(APP_LOG_LEVEL_ERROR,
-                "Sprite position out of bounds: digit=%d, row=%d/%d, col=%d/%d",
-                digit, sprite_row, max_row, sprite_col, max_col);
-        return;
-    }
-    // Calculate source rectangle in the spritesheet
-    GRect source_rect = GRect(
-                            sprite_col * sprite_width,
-                            sprite_row * SPRITE_HEIGHT,
-                            sprite_width,
-                            SPRITE_HEIGHT
-                        );
-    // Calculate destination position
-    GRect dest_rect = GRect(x, y, sprite_width, SPRITE_HEIGHT);
-    // Set compositing mode for transparency
-    graphics_context_set_compositing_mode(ctx, GCompOpSet);
-    // Create a sub-bitmap for the specific sprite
-    GBitmap *sprite_bitmap = gbitmap_create_as_sub_bitmap(sprite_sheet,
-                             source_rect);
-    if (!sprite_bitmap)
-    {
-        APP_LOG(APP_LOG_LEVEL_ERROR, "Failed to create sub-bitmap for digit %d", digit);
-        return;
+        graphics_fill_rect(ctx, square, 0, GCornerNone);
     }
-    // Draw the sprite
-    graphics_draw_bitmap_in_rect(ctx, sprite_bitmap, dest_rect);
-    // Clean up the sub-bitmap
-    gbitmap_destroy(sprite_bitmap);
 }
 
 static void tick_handler(struct tm *tick_time, TimeUnits units_changed)
@@ -515,24 +959,117 @@ static void tick_handler(struct tm *tick_time, TimeUnits units_changed)
     // Update current time values and refresh display
     if (units_changed & SECOND_UNIT)
     {
+        int previous_second = s_current_second;
         s_current_second = tick_time->tm_sec;
-        layer_mark_dirty(s_canvas_layer);
+        // Only repaint if the second dot appears or disappears somewhere;
+        // seconds spent entirely behind the time block change nothing on screen.
+        // The smooth sweep paints on its own frame timer instead.
+        if (s_power_policy.second_dot && !sweep_running() &&
+            (prv_second_visible(previous_second) || prv_second_visible(s_current_second)))
+        {
+            invalidate_post(INVALIDATE_SECOND);
+        }
     }
     if (units_changed & MINUTE_UNIT)
     {
         s_current_minute = tick_time->tm_min;
-        layer_mark_dirty(s_canvas_layer);
+        widgets_handle_minute_tick(tick_time);
+        invalidate_post(INVALIDATE_TIME);
+        // Night schedule and Quiet Time edges are picked up here, no extra timers
+        if (prv_update_seconds_suspended(tick_time->tm_hour))
+        {
+            prv_apply_power_policy();
+        }
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+        if (sweep_running())
+        {
+            // What the sweep cost over the last minute
+            SweepStats stats = sweep_take_stats();
+            LOG_DEBUG("Sweep: %lu frames, %lu over budget, max %u ms, period %u ms",
+                      (unsigned long)stats.frames, (unsigned long)stats.over_budget,
+                      stats.max_cost_ms, stats.interval_ms);
+        }
+#endif
     }
     if (units_changed & HOUR_UNIT)
     {
         s_current_hour = tick_time->tm_hour;
-        layer_mark_dirty(s_canvas_layer);
+        widgets_handle_hour_tick(tick_time);
+        invalidate_post(INVALIDATE_TIME);
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+        // What drove repaints over the last hour, and the event trail
+        invalidate_log_stats();
+        log_dump();
+#endif
+    }
+    if (units_changed & (MINUTE_UNIT | HOUR_UNIT))
+    {
+        prv_update_hour_dot();
     }
+    if (units_changed & DAY_UNIT)
+    {
+        // New day, resolve the day letters again on next draw
+        s_day_plan_valid = false;
+        widgets_handle_day_tick(tick_time);
+        invalidate_post(INVALIDATE_TIME);
+    }
+}
+
+// Startup runs in two phases: init and window load do only what the time and
+// the cached battery and step bars need, and everything else (other widget
+// sheets, day letters, sensors, worker, AppMessage) is deferred until the
+// first frame is out
+#define STARTUP_DEFER_MS 10
+static AppTimer *s_startup_timer = NULL;
+static bool s_startup_complete = false;
+static time_t s_startup_seconds;
+static uint16_t s_startup_ms;
+
+// Milliseconds since init started
+static uint32_t prv_startup_elapsed_ms()
+{
+    time_t seconds;
+    uint16_t ms;
+    time_ms(&seconds, &ms);
+    return (uint32_t)(seconds - s_startup_seconds) * 1000 + ms - s_startup_ms;
 }
 
+// Second startup phase, after the first frame
+static void prv_startup_deferred(void *data)
+{
+    s_startup_timer = NULL;
+    s_startup_complete = true;
+    uint32_t started_ms = prv_startup_elapsed_ms();
+    prv_load_day_sprites();
+    // Widget sheets and sensor subscriptions
+    widgets_init();
+    widgets_set_config(s_settings.widget_config);
+    widgets_set_step_goal(s_settings.step_goal);
+    widgets_set_heart_rate_period(s_settings.heart_rate_period);
+    widgets_set_location(s_settings.latitude_e2, s_settings.longitude_e2);
+    widgets_set_second_tz_offset(s_settings.second_tz_offset);
+    // Today's step count comes from the background worker when it is
+    // enabled; ask for a snapshot so the widgets are current
+    app_worker_message_subscribe(widgets_handle_worker_message);
+    prv_update_worker();
+    // Initialize AppMessage for Clay configuration
+    // Buffers are sized from the settings payload; there is no way to release
+    // them again, so they are kept as small as the payload allows
+    app_message_register_inbox_received(prv_inbox_received_handler);
+    app_message_register_inbox_dropped(prv_inbox_dropped_handler);
+    size_t heap_before = heap_bytes_free();
+    app_message_open(SETTINGS_INBOX_SIZE, SETTINGS_OUTBOX_SIZE);
+    LOG_EVENT("AppMessage: %ld byte inbox, %ld bytes of heap", SETTINGS_INBOX_SIZE,
+              heap_before - heap_bytes_free());
+    LOG_EVENT("Startup: deferred phase took %ld ms", prv_startup_elapsed_ms() - started_ms, 0);
+    // Bring in the widgets and day letters
+    invalidate_post(INVALIDATE_CONFIG);
+}
 
 static void canvas_update_proc(Layer *layer, GContext *ctx)
 {
+    invalidate_frame_begin();
+    sweep_frame_begin();
     // Set background color based on dark mode setting
     if (s_settings.dark_mode)
     {
@@ -542,7 +1079,8 @@ static void canvas_update_proc(Layer *layer, GContext *ctx)
     {
         graphics_context_set_fill_color(ctx, GColorWhite);
     }
-    graphics_fill_rect(ctx, layer_get_bounds(layer), 0, GCornerNone);
+    graphics_fill_rect(ctx, s_full_layout.bounds, 0, GCornerNone);
+    INVALIDATE_COUNT_PAINTED(s_full_layout.bounds.size.w, s_full_layout.bounds.size.h);
     
     // Debug mode: override time, date, and weekday with cycling values
     time_t temp = time(NULL);
@@ -594,242 +1132,75 @@ static void canvas_update_proc(Layer *layer, GContext *ctx)
             hour = 12;
         }
     }
-    // Get hour digits
-    int hour_tens = hour / 10;
-    int hour_ones = hour % 10;
-    // Get minute digits
-    int minute_tens = minute / 10;
-    int minute_ones = minute % 10;
-    // Simplified digit logic:
-    // - Single digit hours use priority (wide), minutes use midpriority
-    // - All two-digit numbers use subpriority
-    DigitType hour_tens_type = DIGIT_SUBPRIORITY;
-    DigitType hour_ones_type = DIGIT_SUBPRIORITY;
-    DigitType minute_tens_type = DIGIT_SUBPRIORITY;
-    DigitType minute_ones_type = DIGIT_SUBPRIORITY;
-    
-    // Single digit hour (1-9) - use priority digit (wide) and midpriority for minutes
-    if (hour_tens == 0)
-    {
-        hour_ones_type = DIGIT_PRIORITY;
-        minute_tens_type = DIGIT_MIDPRIORITY;
-        minute_ones_type = DIGIT_MIDPRIORITY;
-    }
-    // Calculate total width of time display with spacing
-    int total_width = 0;
-    int colon_width = 8;
-    int digit_spacing = 2; // Space between digits
-    // Add hour tens width if present
-    if (hour_tens > 0)
-    {
-        total_width += get_digit_width(hour_tens_type);
-        total_width += digit_spacing; // Space after hour tens
-    }
-    // Add hour ones width
-    total_width += get_digit_width(hour_ones_type);
-    total_width += digit_spacing; // Space after hour ones
-    // Add colon width
-    total_width += colon_width;
-    total_width += digit_spacing; // Space after colon
-    // Add minute tens width
-    total_width += get_digit_width(minute_tens_type);
-    total_width += digit_spacing; // Space after minute tens
-    // Add minute ones width
-    total_width += get_digit_width(minute_ones_type);
-    GRect bounds = layer_get_bounds(layer);
-    // Circular path parameters
-    int center_x = bounds.size.w / 2;
-    int center_y = bounds.size.h / 2;
-    int radius = 50; // Radius of circular path
+    // Recompute the time block only when the displayed time changes
+    prv_update_time_layout(hour, minute);
+    const TimeLayout *time_layout = &s_placement.time;
+    const FaceLayout *face_layout = &s_face_layout;
     // Draw hour and minute dots if enabled
-    if (s_settings.debug_logging) {
-        APP_LOG(APP_LOG_LEVEL_INFO, "Drawing dots - show_hour_minute_dots: %d, show_second_dot: %d", 
-                s_settings.show_hour_minute_dots, s_settings.show_second_dot);
-    }
+    LOG_DEBUG("Drawing dots - show_hour_minute_dots: %d, show_second_dot: %d", 
+              s_settings.show_hour_minute_dots, s_settings.show_second_dot);
     if (s_settings.show_hour_minute_dots) {
         // Draw hour dot around circular path (behind everything)
-        // Calculate angle based on current hour and minutes for more accuracy
-        // 12 hours = 360 degrees, plus minutes contribute to hour position
-        // Convert to 12-hour format for proper positioning
-        int display_hour = s_current_hour % 12;
-        if (display_hour == 0) display_hour = 12; // Handle 12 o'clock case
-        float hour_angle = (((display_hour + (s_current_minute / 60.0f)) / 12.0f) * 2.0f
-                            * M_PI) - M_PI_2;
-        // Calculate hour dot position using trigonometric functions
-        int hour_dot_x = center_x + (int)(radius * my_cos(hour_angle));
-        int hour_dot_y = center_y + (int)(radius * my_sin(hour_angle));
-        // Set hour dot color to gray for visibility
-        if (s_settings.dark_mode)
-        {
-            graphics_context_set_fill_color(ctx, GColorLightGray);
-        }
-        else
-        {
-            graphics_context_set_fill_color(ctx, GColorDarkGray);
-        }
-        // Draw 8px hour dot (behind minute and second hands)
-        graphics_fill_circle(ctx, GPoint(hour_dot_x, hour_dot_y),
-                             4); // 4px radius = 8px diameter
+        // Draw 8px gray hour dot (behind minute and second hands)
+        dots_draw(ctx, DOT_HOUR_MINUTE, s_placement.hour_dot, time_layout->occlusion);
         
         // Draw minute dot around circular path (in front of hour hand)
-        // Calculate angle based on current minute (60 minutes = 360 degrees)
-        // Start at top center (12 o'clock position) by subtracting PI/2
-        float minute_angle = ((s_current_minute / 60.0f) * 2.0f * M_PI) - M_PI_2;
-        // Calculate minute dot position using trigonometric functions
-        int minute_dot_x = center_x + (int)(radius * my_cos(minute_angle));
-        int minute_dot_y = center_y + (int)(radius * my_sin(minute_angle));
-        // Set minute dot color to gray for visibility
-        if (s_settings.dark_mode)
-        {
-            graphics_context_set_fill_color(ctx, GColorLightGray);
-        }
-        else
-        {
-            graphics_context_set_fill_color(ctx, GColorDarkGray);
-        }
-        // Draw 8px minute dot (in front of hour hand)
-        graphics_fill_circle(ctx, GPoint(minute_dot_x, minute_dot_y),
-                             4); // 4px radius = 8px diameter
+        // Minutes share the precomputed ring positions with seconds
+        dots_draw(ctx, DOT_HOUR_MINUTE, face_layout->ring[s_current_minute % RING_POSITIONS],
+                  time_layout->occlusion);
     }
     
-    // Draw second dot if enabled
-    if (s_settings.show_second_dot) {
+    // Draw second dot if enabled and the power policy allows it
+    if (s_power_policy.second_dot) {
         // Draw second dot around circular path (in front of everything)
-        // Calculate angle based on current second (60 seconds = 360 degrees)
-        // Start at top center (12 o'clock position) by subtracting PI/2
-        float angle = ((s_current_second / 60.0f) * 2.0f * M_PI) - M_PI_2;
-        // Calculate dot position using trigonometric functions
-        int dot_x = center_x + (int)(radius * my_cos(angle));
-        int dot_y = center_y + (int)(radius * my_sin(angle));
-        // Set second dot color based on dark mode
-        if (s_settings.dark_mode)
-        {
-            graphics_context_set_fill_color(ctx, GColorWhite);
-        }
-        else
-        {
-            graphics_context_set_fill_color(ctx, GColorBlack);
-        }
         // Draw 8px second dot (in front of minute and hour hands)
-        graphics_fill_circle(ctx, GPoint(dot_x, dot_y), 4); // 4px radius = 8px diameter
-    }
-    // Draw white rectangle behind time display to obscure dot
-    int time_display_height = SPRITE_HEIGHT; // Exact sprite height
-    int time_display_width = total_width; // Exact total width
-    int time_display_x = (bounds.size.w - time_display_width) / 2;
-    int time_display_y = (bounds.size.h - time_display_height) / 2;
-    if (s_settings.dark_mode)
-    {
-        graphics_context_set_fill_color(ctx, GColorBlack);
-    }
-    else
-    {
-        graphics_context_set_fill_color(ctx, GColorWhite);
-    }
-    graphics_fill_rect(ctx, GRect(time_display_x, time_display_y,
-                                  time_display_width, time_display_height), 0, GCornerNone);
-    // Starting X position to center the time display
-    int start_x = (bounds.size.w - total_width) / 2;
-    int y_pos = (bounds.size.h - SPRITE_HEIGHT) / 2;
-    int current_x = start_x;
-    // Draw hour tens digit if present
-    if (hour_tens > 0)
-    {
-        draw_digit(ctx, hour_tens, hour_tens_type, current_x, y_pos);
-        current_x += get_digit_width(hour_tens_type);
-        current_x += digit_spacing; // Space after hour tens
-    }
-    // Draw hour ones digit
-    draw_digit(ctx, hour_ones, hour_ones_type, current_x, y_pos);
-    current_x += get_digit_width(hour_ones_type);
-    current_x += digit_spacing; // Space after hour ones
-    // Draw colon between hours and minutes
-    if (s_settings.dark_mode)
-    {
-        graphics_context_set_fill_color(ctx, GColorWhite);
-    }
-    else
-    {
-        graphics_context_set_fill_color(ctx, GColorBlack);
+        GPoint second_center = sweep_running() ?
+            sweep_position(face_layout, NULL) :
+            face_layout->ring[s_current_second % RING_POSITIONS];
+        dots_draw(ctx, DOT_SECOND, second_center, time_layout->occlusion);
     }
-    graphics_fill_rect(ctx, GRect(current_x + 2, y_pos + 4, 4, 4), 0, GCornerNone);
-    graphics_fill_rect(ctx, GRect(current_x + 2, y_pos + 10, 4, 4), 0, GCornerNone);
-    current_x += colon_width;
-    current_x += digit_spacing; // Space after colon
-    // Draw minute tens digit
-    draw_digit(ctx, minute_tens, minute_tens_type, current_x, y_pos);
-    current_x += get_digit_width(minute_tens_type);
-    current_x += digit_spacing; // Space after minute tens
-    // Draw minute ones digit
-    draw_digit(ctx, minute_ones, minute_ones_type, current_x, y_pos);
+    // Dots never paint inside the time block's occlusion rectangle, so the
+    // digits go straight onto the background with no cover rectangle
+    int y_pos = time_layout->y;
+    // Draw hour digits
+    draw_text(ctx, prv_digit_font(time_layout->hour_type), time_layout->hour_text,
+              time_layout->hour_x, y_pos);
+    // Draw colon between hours and minutes. It doubles as the power policy
+    // indicator: both squares solid at full power, the lower one hollow in
+    // eco and both hollow in power saver.
+    GColor colon_color = s_settings.dark_mode ? GColorWhite : GColorBlack;
+    graphics_context_set_fill_color(ctx, colon_color);
+    graphics_context_set_stroke_color(ctx, colon_color);
+    int colon_x = time_layout->colon_x;
+    prv_draw_colon_square(ctx, GPoint(colon_x + COLON_DOT_X, y_pos + COLON_TOP_Y),
+                          s_power_policy.mode == POWER_POLICY_SAVER);
+    prv_draw_colon_square(ctx, GPoint(colon_x + COLON_DOT_X, y_pos + COLON_BOTTOM_Y),
+                          s_power_policy.mode != POWER_POLICY_FULL);
+    INVALIDATE_COUNT_PAINTED(2 * COLON_DOT_SIZE, COLON_DOT_SIZE);
+    // Draw minute digits
+    draw_text(ctx, prv_digit_font(time_layout->minute_type), time_layout->minute_text,
+              time_layout->minute_x, y_pos);
     // Draw widgets in top corners using the widget system
-    widgets_draw_corner(ctx, CORNER_TOP_LEFT, tick_time);
-    widgets_draw_corner(ctx, CORNER_TOP_RIGHT, tick_time);
-    // Draw day abbreviation in bottom left corner
-    if (s_day_sprites)
+    widgets_draw_corner(ctx, CORNER_TOP_LEFT, face_layout->corner_anchor[CORNER_TOP_LEFT],
+                        tick_time);
+    widgets_draw_corner(ctx, CORNER_TOP_RIGHT, face_layout->corner_anchor[CORNER_TOP_RIGHT],
+                        tick_time);
+    // Draw day abbreviation across the bottom corners
+    if (s_day_font.sheet)
     {
-        int padding_bottom = 10; // Bottom padding
-        int padding_left = 10; // Left padding
         // Use the day_of_week variable (which may be overridden by debug mode)
-        // Map day of week to abbreviation based on setting
-        const char *day_abbrev = "";
-        if (s_settings.use_two_letter_day)
-        {
-            // Two-letter abbreviations
-            switch (day_of_week)
-            {
-                case 0: day_abbrev = "SU"; break;
-                case 1: day_abbrev = "MO"; break;
-                case 2: day_abbrev = "TU"; break;
-                case 3: day_abbrev = "WE"; break;
-                case 4: day_abbrev = "TH"; break;
-                case 5: day_abbrev = "FR"; break;
-                case 6: day_abbrev = "SA"; break;
-                default: day_abbrev = "ER"; break;
-            }
-        }
-        else
-        {
-            // Three-letter abbreviations
-            switch (day_of_week)
-            {
-                case 0: day_abbrev = "SUN"; break;
-                case 1: day_abbrev = "MON"; break;
-                case 2: day_abbrev = "TUE"; break;
-                case 3: day_abbrev = "WED"; break;
-                case 4: day_abbrev = "THU"; break;
-                case 5: day_abbrev = "FRI"; break;
-                case 6: day_abbrev = "SAT"; break;
-                default: day_abbrev = "ERR"; break;
-            }
-        }
-        // Calculate Y position for bottom alignment
-        int y_pos = bounds.size.h - DAY_HEIGHT - padding_bottom;
-        int start_x = padding_left;
-        // Draw day of week abbreviation with split positioning
-        if (s_settings.use_two_letter_day)
+        if (!s_day_plan_valid || s_day_plan.day_of_week != day_of_week)
         {
-            // Two-letter abbreviations: first letter in bottom left, last letter in bottom right
-            draw_day_char(ctx, day_abbrev[0], start_x,
-                          y_pos); // First letter in left corner
-            // Calculate position for last letter in bottom right corner
-            int right_x = bounds.size.w - DAY_WIDTH - padding_left;
-            draw_day_char(ctx, day_abbrev[1], right_x,
-                          y_pos); // Last letter in right corner
-        }
-        else
-        {
-            // Three-letter abbreviations: first letter in bottom left, middle letter in bottom middle, last letter in bottom right
-            draw_day_char(ctx, day_abbrev[0], start_x,
-                          y_pos); // First letter in left corner
-            // Calculate position for middle letter in bottom middle
-            int middle_x = (bounds.size.w - DAY_WIDTH) / 2;
-            draw_day_char(ctx, day_abbrev[1], middle_x, y_pos); // Middle letter in center
-            // Calculate position for last letter in bottom right corner
-            int right_x = bounds.size.w - DAY_WIDTH - padding_left;
-            draw_day_char(ctx, day_abbrev[2], right_x,
-                          y_pos); // Last letter in right corner
+            prv_build_day_plan(day_of_week, s_settings.use_two_letter_day);
         }
+        draw_day_plan(ctx, face_layout);
+    }
+    sweep_frame_end();
+    if (!s_startup_complete && !s_startup_timer)
+    {
+        // First frame drawn; the rest of startup follows once it is on screen
+        LOG_EVENT("Startup: first frame after %ld ms", prv_startup_elapsed_ms(), 0);
+        s_startup_timer = app_timer_register(STARTUP_DEFER_MS, prv_startup_deferred, NULL);
     }
 }
 
@@ -843,68 +1214,77 @@ static void main_window_load(Window *window)
     s_current_second = tick_time->tm_sec;
     s_current_minute = tick_time->tm_min;
     s_current_hour = tick_time->tm_hour;
+    // Resolve the whole face layout for this screen once
+    prv_update_face_layout(bounds, layer_get_unobstructed_bounds(window_layer));
+    prv_update_hour_dot();
     // Create canvas layer for drawing first
     s_canvas_layer = layer_create(bounds);
     layer_set_update_proc(s_canvas_layer, canvas_update_proc);
     layer_add_child(window_layer, s_canvas_layer);
-    // Load sprite sheets for time display (not handled by widgets)
-    s_priority_sprites = gbitmap_create_with_resource(RESOURCE_ID_PRIORITY_DIGIT);
-    s_subpriority_sprites = gbitmap_create_with_resource(
-                                RESOURCE_ID_SUBPRIORITY_DIGIT);
-    s_midpriority_sprites = gbitmap_create_with_resource(
-                                RESOURCE_ID_MIDPRIORITY_DIGIT);
-    s_day_sprites = gbitmap_create_with_resource(RESOURCE_ID_DAY_SPRITES);
-    // Check if resources loaded successfully
-    if (!s_priority_sprites)
-    {
-        APP_LOG(APP_LOG_LEVEL_ERROR, "Failed to load priority digit sprite sheet");
-    }
-    else
+    // Load sprite sheets for time display (not handled by widgets), with the
+    // palette for the current dark mode setting, plus the battery and step
+    // bars so they show their cached values; the day letters and the other
+    // widget sheets follow in the deferred startup phase
+    prv_load_time_sprites();
+    widgets_load_cached_sprites(s_settings.widget_config);
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+    if (s_priority_font.sheet)
     {
-        GSize size = gbitmap_get_bounds(s_priority_sprites).size;
-        if (s_settings.debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "Priority sprite sheet loaded: %dx%d", size.w,
-                    size.h);
-        }
+        GSize size = gbitmap_get_bounds(s_priority_font.sheet).size;
+        LOG_DEBUG("Priority sprite sheet loaded: %dx%d", size.w, size.h);
     }
-    if (!s_day_sprites)
-    {
-        APP_LOG(APP_LOG_LEVEL_ERROR, "Failed to load day sprite sheet");
-    }
-    else
-    {
-        GSize size = gbitmap_get_bounds(s_day_sprites).size;
-        if (s_settings.debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "Day sprite sheet loaded: %dx%d", size.w, size.h);
-        }
-    }
-    // Invert palette colors for dark mode
-    if (s_settings.dark_mode)
-    {
-        invert_bitmap_palette(s_priority_sprites);
-        invert_bitmap_palette(s_subpriority_sprites);
-        invert_bitmap_palette(s_midpriority_sprites);
-        invert_bitmap_palette(s_day_sprites);
-    }
-    // Force initial redraw
-    layer_mark_dirty(s_canvas_layer);
-    // Subscribe to tick timer service for updates - include all time units for rotating dots
-    tick_timer_service_subscribe(MINUTE_UNIT | SECOND_UNIT | HOUR_UNIT,
-                                 tick_handler);
+#endif
+    // All repaints go through the invalidation scheduler; force the first one
+    invalidate_attach(s_canvas_layer);
+    invalidate_post(INVALIDATE_LAYOUT);
+    // Subscribe to the tick units the power policy allows, and follow the battery
+    prv_update_seconds_suspended(tick_time->tm_hour);
+    prv_update_tap_subscription();
+    prv_apply_power_policy();
+    widgets_set_battery_listener(prv_battery_listener);
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+    // Follow Timeline Quick View using the precomputed layouts
+    unobstructed_area_service_subscribe((UnobstructedAreaHandlers) {
+        .will_change = prv_unobstructed_will_change,
+        .change = prv_unobstructed_change,
+        .did_change = prv_unobstructed_did_change
+    }, NULL);
+#endif
 }
 
 static void main_window_unload(Window *window)
 {
     // Clean up resources
+#if PBL_API_EXISTS(unobstructed_area_service_subscribe)
+    unobstructed_area_service_unsubscribe();
+#endif
+    widgets_set_battery_listener(NULL);
+    tick_timer_service_unsubscribe();
+    if (s_tap_subscribed)
+    {
+        accel_tap_service_unsubscribe();
+        s_tap_subscribed = false;
+    }
+    if (s_tap_burst_timer)
+    {
+        app_timer_cancel(s_tap_burst_timer);
+        s_tap_burst_timer = NULL;
+    }
+    sweep_stop();
+    s_power_policy_applied = false;
+    invalidate_attach(NULL);
     layer_destroy(s_canvas_layer);
-    gbitmap_destroy(s_priority_sprites);
-    gbitmap_destroy(s_subpriority_sprites);
-    gbitmap_destroy(s_midpriority_sprites);
-    gbitmap_destroy(s_day_sprites);
+    s_canvas_layer = NULL;
+    font_unload(&s_priority_font);
+    font_unload(&s_subpriority_font);
+    font_unload(&s_midpriority_font);
+    font_unload(&s_day_font);
+    dots_unload();
 }
 
 static void init()
 {
+    time_ms(&s_startup_seconds, &s_startup_ms);
     // Initialize settings with defaults first
     s_settings = get_default_settings();
     
@@ -917,7 +1297,7 @@ static void init()
     
     // Link settings to widget system
     s_settings_dark_mode = s_settings.dark_mode;
-    s_settings_debug_logging = s_settings.debug_logging;
+    s_settings_use_24_hour_format = s_settings.use_24_hour_format;
     
     // Start debug timer if debug mode is enabled in config
     if (s_settings.debug_mode && !s_debug_timer) {
@@ -925,14 +1305,8 @@ static void init()
         s_debug_timer = app_timer_register(500, debug_timer_callback, NULL);
     }
     
-    // Initialize widget system
-    widgets_init();
-    
-    // Set widget configuration from saved settings
-    widgets_set_config(s_settings.widget_config);
-    
-    // Set step goal from saved settings
-    widgets_set_step_goal(s_settings.step_goal);
+    // Last-known battery and steps, so their widgets are on the first frame
+    widgets_restore_cache();
     
     // Create main Window element and assign to pointer
     s_main_window = window_create();
@@ -942,15 +1316,25 @@ static void init()
         .load = main_window_load,
         .unload = main_window_unload
     });
-    // Show the Window on the watch, with animated=true
-    window_stack_push(s_main_window, true);
-    // Initialize AppMessage for Clay configuration
-    app_message_register_inbox_received(prv_inbox_received_handler);
-    app_message_open(128, 128);
+    // Show the Window on the watch straight away rather than after a push
+    // animation; the first frame only needs the time
+    window_stack_push(s_main_window, false);
 }
 
 static void deinit()
 {
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+    // Leave the event trail and repaint counters in the app log on the way
+    // out; release builds only dump when the settings page asks for it
+    invalidate_log_stats();
+    log_dump();
+#endif
+    if (s_startup_timer)
+    {
+        app_timer_cancel(s_startup_timer);
+        s_startup_timer = NULL;
+    }
+    app_worker_message_unsubscribe();
     // Deinitialize widget system
     widgets_deinit();
     
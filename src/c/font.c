@@ -0,0 +1,117 @@
+#include "font.h"
+#include <pebble.h>
+#include "log.h"
+#include "invalidate.h"
+
+// Layout: 1,2,3,4,5,6,7,8,9,0 (0 sits alone in the last row)
+const uint8_t FONT_LOOKUP_DIGITS[FONT_LOOKUP_SIZE] = {
+    ['1'] = 1, ['2'] = 2, ['3'] = 3, ['4'] = 4, ['5'] = 5,
+    ['6'] = 6, ['7'] = 7, ['8'] = 8, ['9'] = 9, ['0'] = 10
+};
+
+// Layout: A,D,E,F,H,I,M,N,O,R,S,T,U,W
+const uint8_t FONT_LOOKUP_DAY[FONT_LOOKUP_SIZE] = {
+    ['A'] = 1, ['D'] = 2, ['E'] = 3, ['F'] = 4, ['H'] = 5, ['I'] = 6, ['M'] = 7,
+    ['N'] = 8, ['O'] = 9, ['R'] = 10, ['S'] = 11, ['T'] = 12, ['U'] = 13, ['W'] = 14
+};
+
+// Layout: P (PM) above A (AM)
+const uint8_t FONT_LOOKUP_AM_PM[FONT_LOOKUP_SIZE] = {
+    ['P'] = 1, ['A'] = 2
+};
+
+// Load a sprite sheet and resolve every glyph rectangle up front, so drawing
+// never has to validate the sheet again
+bool font_load(Font *font, uint32_t resource_id, const uint8_t *lookup,
+               GSize cell, int per_row, int glyph_count, int spacing) {
+    font_unload(font);
+    font->lookup = lookup;
+    font->cell = cell;
+    font->spacing = spacing;
+    font->glyph_count = 0;
+    font->sheet = gbitmap_create_with_resource(resource_id);
+    if (!font->sheet) {
+        LOG_ERROR("Failed to load font sheet %d", (int)resource_id);
+        return false;
+    }
+    // Validate sprite sheet bounds
+    GSize sheet_size = gbitmap_get_bounds(font->sheet).size;
+    int max_col = cell.w > 0 ? sheet_size.w / cell.w : 0;
+    int max_row = cell.h > 0 ? sheet_size.h / cell.h : 0;
+    if (glyph_count > FONT_MAX_GLYPHS) {
+        glyph_count = FONT_MAX_GLYPHS;
+    }
+    for (int i = 0; i < glyph_count; i++) {
+        int row = i / per_row;
+        int col = i % per_row;
+        if (col >= max_col || row >= max_row) {
+            LOG_ERROR("Font sheet %d too small: glyph %d at row=%d/%d, col=%d/%d",
+                      (int)resource_id, i, row, max_row, col, max_col);
+            break;
+        }
+        font->glyphs[i] = GRect(col * cell.w, row * cell.h, cell.w, cell.h);
+        font->glyph_count++;
+    }
+    return font->glyph_count > 0;
+}
+
+// Release a font's sprite sheet
+void font_unload(Font *font) {
+    if (font->sheet) {
+        gbitmap_destroy(font->sheet);
+        font->sheet = NULL;
+    }
+    font->glyph_count = 0;
+}
+
+// Glyph index for a character, or -1 if the font doesn't have it
+int font_glyph_index(const Font *font, char character) {
+    if (!font->lookup) return -1; // Frame strips are drawn by index only
+    int glyph = font->lookup[(uint8_t)character] - 1;
+    return (glyph < font->glyph_count) ? glyph : -1;
+}
+
+// Width of a run of glyphs, without trailing spacing
+int font_text_width(const Font *font, const char *text) {
+    int width = 0;
+    int count = 0;
+    for (const char *c = text; *c; c++) {
+        if (font_glyph_index(font, *c) >= 0) {
+            width += font->cell.w;
+            count++;
+        }
+    }
+    return count > 0 ? width + (count - 1) * font->spacing : 0;
+}
+
+// Blit a single glyph by index
+void draw_glyph(GContext *ctx, const Font *font, int glyph, int x, int y) {
+    if (!font->sheet) return;
+    if (glyph < 0 || glyph >= font->glyph_count) {
+        // A bad frame index would repeat on every frame, so this is rate limited
+        LOG_ERROR_LIMITED("Glyph %d out of range (%d glyphs)", glyph, font->glyph_count);
+        return;
+    }
+    // Point the sheet's bounds at the glyph instead of allocating a sub-bitmap
+    gbitmap_set_bounds(font->sheet, font->glyphs[glyph]);
+    INVALIDATE_COUNT_PAINTED(font->cell.w, font->cell.h);
+    graphics_context_set_compositing_mode(ctx, GCompOpSet);
+    graphics_draw_bitmap_in_rect(ctx, font->sheet, GRect(x, y, font->cell.w, font->cell.h));
+}
+
+// Draw a run of glyphs left to right, returns the width drawn
+int draw_text(GContext *ctx, const Font *font, const char *text, int x, int y) {
+    if (!font->sheet) return 0;
+    graphics_context_set_compositing_mode(ctx, GCompOpSet);
+    int start_x = x;
+    int advance = font->cell.w + font->spacing;
+    for (const char *c = text; *c; c++) {
+        int glyph = font_glyph_index(font, *c);
+        if (glyph < 0) continue; // Characters the sheet doesn't have are skipped
+        gbitmap_set_bounds(font->sheet, font->glyphs[glyph]);
+        INVALIDATE_COUNT_PAINTED(font->cell.w, font->cell.h);
+        graphics_draw_bitmap_in_rect(ctx, font->sheet, GRect(x, y, font->cell.w, font->cell.h));
+        x += advance;
+    }
+    return (x > start_x) ? x - start_x - font->spacing : 0;
+}
@@ -0,0 +1,37 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include <pebble.h>
+
+// Largest sprite sheet (day.png has 14 letters)
+#define FONT_MAX_GLYPHS 16
+
+// Character lookup tables: entry is glyph index + 1, 0 means no glyph.
+// Declared as designated initializers so they live in the binary, not the heap.
+#define FONT_LOOKUP_SIZE 256
+
+// Bitmap font over a sprite sheet of equally sized cells
+typedef struct {
+    GBitmap *sheet;
+    const uint8_t *lookup;          // FONT_LOOKUP_SIZE entries, NULL for frame strips
+    GRect glyphs[FONT_MAX_GLYPHS];  // Validated cell rectangles in the sheet
+    uint8_t glyph_count;
+    GSize cell;
+    int8_t spacing;                 // Gap between glyphs in a run
+} Font;
+
+// Shared character sets
+extern const uint8_t FONT_LOOKUP_DIGITS[FONT_LOOKUP_SIZE];   // 1,2,3,4,5,6,7,8,9,0
+extern const uint8_t FONT_LOOKUP_DAY[FONT_LOOKUP_SIZE];      // A,D,E,F,H,I,M,N,O,R,S,T,U,W
+extern const uint8_t FONT_LOOKUP_AM_PM[FONT_LOOKUP_SIZE];    // P,A
+
+// Function declarations
+bool font_load(Font *font, uint32_t resource_id, const uint8_t *lookup,
+               GSize cell, int per_row, int glyph_count, int spacing);
+void font_unload(Font *font);
+int font_glyph_index(const Font *font, char character);
+int font_text_width(const Font *font, const char *text);
+void draw_glyph(GContext *ctx, const Font *font, int glyph, int x, int y);
+int draw_text(GContext *ctx, const Font *font, const char *text, int x, int y);
+
+#endif // FONT_H
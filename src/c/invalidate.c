@@ -0,0 +1,86 @@
+#include "invalidate.h"
+#include <pebble.h>
+
+// Every event source posts here instead of dirtying layers itself. The first
+// post in an event-loop turn marks the layer dirty; later ones only add their
+// reason to the pending set, which the next render consumes.
+static Layer *s_layer = NULL;
+static uint32_t s_pending = 0; // Bit per InvalidateReason
+
+// Field counters: how often each reason was posted, and how many repaints it
+// took part in after coalescing
+static uint32_t s_posts[INVALIDATE_REASON_COUNT];
+static uint32_t s_repaints[INVALIDATE_REASON_COUNT];
+static uint32_t s_frames = 0;
+// Overdraw counters, see INVALIDATE_COUNT_PAINTED
+static uint32_t s_pixels_painted = 0;
+static uint32_t s_pixels_avoided = 0;
+
+// One LOG_EVENT format per reason, since the ring stores formats and integers only
+static const char *const s_reason_formats[INVALIDATE_REASON_COUNT] = {
+    "Repaint second: %ld posts, %ld frames",
+    "Repaint sweep: %ld posts, %ld frames",
+    "Repaint time: %ld posts, %ld frames",
+    "Repaint battery: %ld posts, %ld frames",
+    "Repaint steps: %ld posts, %ld frames",
+    "Repaint heart rate: %ld posts, %ld frames",
+    "Repaint connection: %ld posts, %ld frames",
+    "Repaint config: %ld posts, %ld frames",
+    "Repaint layout: %ld posts, %ld frames",
+    "Repaint debug: %ld posts, %ld frames"
+};
+
+// Layer to invalidate, or NULL while there is none (posts are then dropped)
+void invalidate_attach(Layer *layer) {
+    s_layer = layer;
+    s_pending = 0;
+}
+
+void invalidate_post(InvalidateReason reason) {
+    if (!s_layer || reason >= INVALIDATE_REASON_COUNT) return;
+    s_posts[reason]++;
+    if (!s_pending) {
+        layer_mark_dirty(s_layer);
+    }
+    s_pending |= 1u << reason;
+}
+
+// Called at the top of the update proc: the pending reasons are now painted
+void invalidate_frame_begin(void) {
+    s_frames++;
+    for (int i = 0; i < INVALIDATE_REASON_COUNT; i++) {
+        if (s_pending & (1u << i)) {
+            s_repaints[i]++;
+        }
+    }
+    s_pending = 0;
+}
+
+// Add to the overdraw counters
+void invalidate_count_pixels(uint32_t painted, uint32_t avoided) {
+    s_pixels_painted += painted;
+    s_pixels_avoided += avoided;
+}
+
+// Write the counters since the last call to the event ring and reset them.
+// Called just before log_dump, so the settings page's dump shows them in any
+// build with the ring compiled in.
+void invalidate_log_stats(void) {
+    LOG_EVENT("Repaints: %ld frames", s_frames, 0);
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+    if (s_frames && (s_pixels_painted || s_pixels_avoided)) {
+        LOG_EVENT("Pixels per frame: %ld painted, %ld avoided",
+                  s_pixels_painted / s_frames, s_pixels_avoided / s_frames);
+    }
+#endif
+    for (int i = 0; i < INVALIDATE_REASON_COUNT; i++) {
+        if (s_posts[i]) {
+            LOG_EVENT(s_reason_formats[i], s_posts[i], s_repaints[i]);
+        }
+    }
+    memset(s_posts, 0, sizeof(s_posts));
+    memset(s_repaints, 0, sizeof(s_repaints));
+    s_frames = 0;
+    s_pixels_painted = 0;
+    s_pixels_avoided = 0;
+}
@@ -0,0 +1,41 @@
+#ifndef INVALIDATE_H
+#define INVALIDATE_H
+
+#include <pebble.h>
+#include "log.h"
+
+// Why the face needs repainting
+typedef enum {
+    INVALIDATE_SECOND = 0, // Second dot moved
+    INVALIDATE_SWEEP,      // Smooth sweep frame
+    INVALIDATE_TIME,       // Minute, hour or day changed
+    INVALIDATE_BATTERY,
+    INVALIDATE_STEPS,
+    INVALIDATE_HEART_RATE,
+    INVALIDATE_CONNECTION, // Phone connected or disconnected
+    INVALIDATE_CONFIG,     // Settings or power policy changed
+    INVALIDATE_LAYOUT,     // Window load or unobstructed area change
+    INVALIDATE_DEBUG,      // Debug mode cycling
+    INVALIDATE_REASON_COUNT
+} InvalidateReason;
+
+// Function declarations
+void invalidate_attach(Layer *layer);
+void invalidate_post(InvalidateReason reason);
+void invalidate_frame_begin(void);
+void invalidate_log_stats(void);
+void invalidate_count_pixels(uint32_t painted, uint32_t avoided);
+
+// Overdraw counters: pixels each frame paints, and dot pixels it skips
+// because they fall behind the time block (tools/dotscheck.py checks the two
+// add up to the full stamps). Only compiled in at LOG_LEVEL_DEBUG; the totals
+// go out with invalidate_log_stats.
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define INVALIDATE_COUNT_PAINTED(w, h) invalidate_count_pixels((uint32_t)((w) * (h)), 0)
+#define INVALIDATE_COUNT_AVOIDED(w, h) invalidate_count_pixels(0, (uint32_t)((w) * (h)))
+#else
+#define INVALIDATE_COUNT_PAINTED(w, h) do { } while (0)
+#define INVALIDATE_COUNT_AVOIDED(w, h) do { } while (0)
+#endif
+
+#endif // INVALIDATE_H
@@ -0,0 +1,194 @@
+#include "layout.h"
+#include <pebble.h>
+#include "math.h"
+
+// Helper function to get digit width based on type
+int layout_digit_width(DigitType type)
+{
+    switch (type)
+    {
+        case DIGIT_PRIORITY:
+            return PRIORITY_WIDTH;
+        case DIGIT_SUBPRIORITY:
+            return SUBPRIORITY_WIDTH;
+        case DIGIT_MIDPRIORITY:
+            return MIDPRIORITY_WIDTH;
+        default:
+            return SUBPRIORITY_WIDTH; // Default fallback
+    }
+}
+
+// Work out digit types and positions for the centered time block
+void layout_compute_time(TimeLayout *layout, GRect bounds, int hour, int minute)
+{
+    layout->hour = hour;
+    layout->minute = minute;
+    snprintf(layout->hour_text, sizeof(layout->hour_text), "%d", hour);
+    snprintf(layout->minute_text, sizeof(layout->minute_text), "%02d", minute);
+    int hour_digits = (hour >= 10) ? 2 : 1;
+    // Simplified digit logic:
+    // - Single digit hours use priority (wide), minutes use midpriority
+    // - All two-digit numbers use subpriority
+    layout->hour_type = (hour_digits == 1) ? DIGIT_PRIORITY : DIGIT_SUBPRIORITY;
+    layout->minute_type = (hour_digits == 1) ? DIGIT_MIDPRIORITY : DIGIT_SUBPRIORITY;
+    int hour_width = hour_digits * layout_digit_width(layout->hour_type) +
+                     (hour_digits - 1) * DIGIT_SPACING;
+    int minute_width = 2 * layout_digit_width(layout->minute_type) + DIGIT_SPACING;
+    // Calculate total width of time display with spacing around the colon
+    layout->total_width = hour_width + DIGIT_SPACING + COLON_WIDTH + DIGIT_SPACING + minute_width;
+    // Starting X position to center the time display
+    layout->hour_x = (bounds.size.w - layout->total_width) / 2;
+    layout->colon_x = layout->hour_x + hour_width + DIGIT_SPACING;
+    layout->minute_x = layout->colon_x + COLON_WIDTH + DIGIT_SPACING;
+    layout->y = (bounds.size.h - SPRITE_HEIGHT) / 2;
+    layout->occlusion = GRect(layout->hour_x, layout->y, layout->total_width, SPRITE_HEIGHT);
+}
+
+// Scale a length from the 144px reference design to these bounds
+static int layout_scale(int value, GRect bounds)
+{
+    int size = (bounds.size.w < bounds.size.h) ? bounds.size.w : bounds.size.h;
+#if defined(PBL_ROUND)
+    // Only the square inscribed in the circle is usable like the rectangular design
+    size = size * 181 / 256; // 1/sqrt(2)
+#endif
+    return value * size / LAYOUT_REFERENCE_SIZE;
+}
+
+// Point at a fraction of a turn clockwise from 12 o'clock
+static GPoint polar_point(GPoint center, int radius, float turns)
+{
+    float angle = (turns * 2.0f * M_PI) - M_PI_2;
+    return GPoint(center.x + (int)(radius * my_cos(angle)),
+                  center.y + (int)(radius * my_sin(angle)));
+}
+
+// Point on the dot ring, position/positions of the way round from 12 o'clock
+GPoint layout_ring_point(const FaceLayout *layout, int position, int positions)
+{
+    return polar_point(layout->center, layout->ring_radius, (float)position / positions);
+}
+
+// Derive every position on the face from the layer bounds
+void layout_compute_face(FaceLayout *layout, GRect bounds)
+{
+    int padding = layout_scale(LAYOUT_PADDING, bounds);
+    layout->bounds = bounds;
+    layout->center = GPoint(bounds.size.w / 2, bounds.size.h / 2);
+    layout->ring_radius = layout_scale(LAYOUT_RING_RADIUS, bounds);
+    // Precompute dot centers around the ring (60 steps = 360 degrees, starting at 12 o'clock)
+    for (int i = 0; i < RING_POSITIONS; i++)
+    {
+        layout->ring[i] = layout_ring_point(layout, i, RING_POSITIONS);
+    }
+#if defined(PBL_ROUND)
+    // Square corners are cut off on a round screen, so widgets and day letters
+    // are anchored to points on a circle just inside the bezel instead
+    int screen_radius = layout->center.x;
+    int corner_radius = screen_radius - padding;
+    // The widget's outer top corner sits on the circle
+    layout->corner_anchor[CORNER_TOP_LEFT] =
+        polar_point(layout->center, corner_radius, (360 - LAYOUT_ROUND_CORNER_ANGLE) / 360.0f);
+    layout->corner_anchor[CORNER_TOP_RIGHT] =
+        polar_point(layout->center, corner_radius, LAYOUT_ROUND_CORNER_ANGLE / 360.0f);
+    // Day letters are centered on a smaller circle so their corners clear the
+    // bezel: (w + h) / 3 is a little under half the letter's diagonal (11px
+    // against 12px for 20x14), close enough without a square root
+    int day_radius = corner_radius - (DAY_WIDTH + DAY_HEIGHT) / 3;
+    const int day_angles[DAY_SLOT_COUNT] = {
+        180 + LAYOUT_ROUND_DAY_ANGLE, 180, 180 - LAYOUT_ROUND_DAY_ANGLE
+    };
+    for (int i = 0; i < DAY_SLOT_COUNT; i++)
+    {
+        GPoint center = polar_point(layout->center, day_radius, day_angles[i] / 360.0f);
+        layout->day_slot[i] = GPoint(center.x - DAY_WIDTH / 2, center.y - DAY_HEIGHT / 2);
+    }
+#else
+    // Widgets hang from the top corners
+    layout->corner_anchor[CORNER_TOP_LEFT] = GPoint(padding, padding);
+    layout->corner_anchor[CORNER_TOP_RIGHT] = GPoint(bounds.size.w - padding, padding);
+    // Day letters sit along the bottom edge
+    int day_y = bounds.size.h - DAY_HEIGHT - padding;
+    layout->day_slot[DAY_SLOT_LEFT] = GPoint(padding, day_y);
+    layout->day_slot[DAY_SLOT_MIDDLE] = GPoint((bounds.size.w - DAY_WIDTH) / 2, day_y);
+    layout->day_slot[DAY_SLOT_RIGHT] = GPoint(bounds.size.w - DAY_WIDTH - padding, day_y);
+#endif
+}
+
+// Integer step from a to b, progress/progress_max of the way
+static int lerp(int a, int b, int32_t progress, int32_t progress_max)
+{
+    return a + (int)(((int32_t)(b - a) * progress) / progress_max);
+}
+
+static GPoint lerp_point(GPoint a, GPoint b, int32_t progress, int32_t progress_max)
+{
+    return GPoint(lerp(a.x, b.x, progress, progress_max), lerp(a.y, b.y, progress, progress_max));
+}
+
+// Integer blend of a single point, for positions kept outside a FaceLayout
+GPoint layout_interpolate_point(GPoint from, GPoint to, int32_t progress, int32_t progress_max)
+{
+    return lerp_point(from, to, progress, progress_max);
+}
+
+// Blend two precomputed layouts point by point, with no trig, for animations
+// between them (e.g. a Timeline Quick View sliding in)
+void layout_interpolate_face(FaceLayout *out, const FaceLayout *from, const FaceLayout *to,
+                             int32_t progress, int32_t progress_max)
+{
+    out->bounds.origin = lerp_point(from->bounds.origin, to->bounds.origin, progress, progress_max);
+    out->bounds.size.w = lerp(from->bounds.size.w, to->bounds.size.w, progress, progress_max);
+    out->bounds.size.h = lerp(from->bounds.size.h, to->bounds.size.h, progress, progress_max);
+    out->center = lerp_point(from->center, to->center, progress, progress_max);
+    out->ring_radius = lerp(from->ring_radius, to->ring_radius, progress, progress_max);
+    for (int i = 0; i < RING_POSITIONS; i++)
+    {
+        out->ring[i] = lerp_point(from->ring[i], to->ring[i], progress, progress_max);
+    }
+    for (int i = 0; i < CORNER_COUNT; i++)
+    {
+        out->corner_anchor[i] = lerp_point(from->corner_anchor[i], to->corner_anchor[i],
+                                           progress, progress_max);
+    }
+    for (int i = 0; i < DAY_SLOT_COUNT; i++)
+    {
+        out->day_slot[i] = lerp_point(from->day_slot[i], to->day_slot[i], progress, progress_max);
+    }
+}
+
+// Blend the time block's position between two layouts of the same time. Text,
+// digit types and sizes are taken from the target, so a time change part way
+// through an animation lands on the right glyphs.
+void layout_interpolate_time(TimeLayout *out, const TimeLayout *from, const TimeLayout *to,
+                             int32_t progress, int32_t progress_max)
+{
+    *out = *to;
+    out->hour_x = lerp(from->hour_x, to->hour_x, progress, progress_max);
+    out->colon_x = lerp(from->colon_x, to->colon_x, progress, progress_max);
+    out->minute_x = lerp(from->minute_x, to->minute_x, progress, progress_max);
+    out->y = lerp(from->y, to->y, progress, progress_max);
+    out->occlusion.origin = lerp_point(from->occlusion.origin, to->occlusion.origin,
+                                       progress, progress_max);
+}
+
+// Bit N is set when a dot at ring position N shows at least one pixel, i.e.
+// it is not entirely behind the time block's occlusion rectangle
+uint64_t layout_second_visibility(const TimeLayout *layout, const GPoint ring[RING_POSITIONS],
+                                  int dot_radius)
+{
+    const GRect *occ = &layout->occlusion;
+    uint64_t visible = 0;
+    for (int i = 0; i < RING_POSITIONS; i++)
+    {
+        bool hidden = ring[i].x - dot_radius >= occ->origin.x &&
+                      ring[i].x + dot_radius <= occ->origin.x + occ->size.w &&
+                      ring[i].y - dot_radius >= occ->origin.y &&
+                      ring[i].y + dot_radius <= occ->origin.y + occ->size.h;
+        if (!hidden)
+        {
+            visible |= (uint64_t)1 << i;
+        }
+    }
+    return visible;
+}
@@ -0,0 +1,97 @@
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <pebble.h>
+#include "widgets.h"
+// Sprite sheet dimensions (PRIORITY_WIDTH, SPRITE_HEIGHT, DAY_WIDTH, ...) for
+// the platform being built, generated from the PNGs by tools/glyphgen.py
+#include "glyphs.auto.h"
+
+// Time display spacing
+#define COLON_WIDTH GLYPH_SCALE(8)
+#define DIGIT_SPACING GLYPH_SCALE(2) // Space between digits
+
+// Colon squares inside COLON_WIDTH
+#define COLON_DOT_X GLYPH_SCALE(2)
+#define COLON_DOT_SIZE GLYPH_SCALE(4)
+#define COLON_TOP_Y GLYPH_SCALE(4)
+#define COLON_BOTTOM_Y GLYPH_SCALE(10)
+
+// Digit types for width selection
+typedef enum
+{
+    DIGIT_PRIORITY,
+    DIGIT_SUBPRIORITY,
+    DIGIT_MIDPRIORITY
+} DigitType;
+
+// Placement of the HH:MM block, recomputed only when the displayed time changes
+typedef struct
+{
+    int hour;   // Displayed hour (already converted to 12/24 hour format)
+    int minute;
+    // Both hour digits share a font, as do both minute digits
+    char hour_text[3];
+    char minute_text[3];
+    DigitType hour_type;
+    DigitType minute_type;
+    int hour_x;
+    int colon_x;
+    int minute_x;
+    int y;
+    int total_width;
+    // Pixels the time block paints over; anything behind it is never drawn
+    GRect occlusion;
+} TimeLayout;
+
+// Positions on the dot ring, one per second/minute
+#define RING_POSITIONS 60
+
+// Proportions of the original 144px wide design; everything scales from these
+#define LAYOUT_REFERENCE_SIZE 144
+#define LAYOUT_RING_RADIUS 50
+#define LAYOUT_PADDING 10
+
+// Round displays: angles (degrees clockwise from 12 o'clock) of the polar anchors
+#define LAYOUT_ROUND_CORNER_ANGLE 40 // Widgets hang at -40 and +40 degrees
+#define LAYOUT_ROUND_DAY_ANGLE 40    // Outer day letters sit 40 degrees either side of 6 o'clock
+
+// Widget slots
+#define CORNER_COUNT 2
+
+// Bottom row letter slots
+typedef enum
+{
+    DAY_SLOT_LEFT = 0,
+    DAY_SLOT_MIDDLE,
+    DAY_SLOT_RIGHT,
+    DAY_SLOT_COUNT
+} DaySlot;
+
+// Screen-wide placement, derived from the layer bounds once at window load
+typedef struct
+{
+    GRect bounds;
+    GPoint center;
+    int ring_radius;
+    GPoint ring[RING_POSITIONS];
+    // Top-left of the left widget, top-right of the right widget (right aligned)
+    GPoint corner_anchor[CORNER_COUNT];
+    // Top-left of each bottom row letter
+    GPoint day_slot[DAY_SLOT_COUNT];
+} FaceLayout;
+
+// Function declarations
+int layout_digit_width(DigitType type);
+void layout_compute_time(TimeLayout *layout, GRect bounds, int hour, int minute);
+void layout_compute_face(FaceLayout *layout, GRect bounds);
+GPoint layout_ring_point(const FaceLayout *layout, int position, int positions);
+GPoint layout_interpolate_point(GPoint from, GPoint to, int32_t progress, int32_t progress_max);
+void layout_interpolate_face(FaceLayout *out, const FaceLayout *from, const FaceLayout *to,
+                             int32_t progress, int32_t progress_max);
+void layout_interpolate_time(TimeLayout *out, const TimeLayout *from, const TimeLayout *to,
+                             int32_t progress, int32_t progress_max);
+uint64_t layout_second_visibility(const TimeLayout *layout, const GPoint ring[RING_POSITIONS],
+                                  int dot_radius);
+
+#endif // LAYOUT_H
@@ -0,0 +1,80 @@
+#include "log.h"
+#include <pebble.h>
+
+// Text logging is chosen at compile time in log.h. What is left here is the
+// rate limiter for repeated errors and the event ring, which keeps compact
+// binary records (a format pointer, two integers and a timestamp) and only
+// formats them when asked to dump.
+
+// Let a rate-limited call site through, reporting how many were held back
+bool log_limit_pass(LogLimit *limit) {
+    time_t now = time(NULL);
+    if (limit->last && now - limit->last < LOG_LIMIT_SECONDS) {
+        if (limit->suppressed < UINT16_MAX) {
+            limit->suppressed++;
+        }
+        return false;
+    }
+    if (limit->suppressed) {
+        APP_LOG(APP_LOG_LEVEL_WARNING, "(%u repeats of the next message suppressed)",
+                (unsigned)limit->suppressed);
+    }
+    limit->last = now;
+    limit->suppressed = 0;
+    return true;
+}
+
+#if LOG_RING_SIZE > 0
+
+typedef struct {
+    const char *format;
+    uint32_t time;
+    int32_t a;
+    int32_t b;
+} LogRecord;
+
+static LogRecord s_ring[LOG_RING_SIZE];
+static uint16_t s_ring_head = 0;  // Next record to write
+static uint16_t s_ring_count = 0;
+static uint32_t s_ring_dropped = 0; // Overwritten before a dump
+
+// Append a record, overwriting the oldest once the ring is full
+void log_event(const char *format, int32_t a, int32_t b) {
+    LogRecord *record = &s_ring[s_ring_head];
+    record->format = format;
+    record->time = (uint32_t)time(NULL);
+    record->a = a;
+    record->b = b;
+    s_ring_head = (s_ring_head + 1) % LOG_RING_SIZE;
+    if (s_ring_count < LOG_RING_SIZE) {
+        s_ring_count++;
+    } else {
+        s_ring_dropped++;
+    }
+}
+
+// Format and log the ring oldest first, then empty it
+void log_dump(void) {
+    char text[64];
+    APP_LOG(APP_LOG_LEVEL_INFO, "Log: %u events, %lu overwritten",
+            (unsigned)s_ring_count, (unsigned long)s_ring_dropped);
+    uint16_t index = (s_ring_head + LOG_RING_SIZE - s_ring_count) % LOG_RING_SIZE;
+    for (uint16_t i = 0; i < s_ring_count; i++) {
+        const LogRecord *record = &s_ring[index];
+        snprintf(text, sizeof(text), record->format, (long)record->a, (long)record->b);
+        APP_LOG(APP_LOG_LEVEL_INFO, "%lu %s", (unsigned long)record->time, text);
+        index = (index + 1) % LOG_RING_SIZE;
+    }
+    s_ring_count = 0;
+    s_ring_dropped = 0;
+}
+
+#else
+
+void log_event(const char *format, int32_t a, int32_t b) {
+}
+
+void log_dump(void) {
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <pebble.h>
+
+// Log levels, most severe first
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+// Highest level compiled in. Calls above it are removed by the preprocessor,
+// arguments included, so they cost nothing at run time. Build with
+// -DLOG_LEVEL=LOG_LEVEL_DEBUG for the old debug logging.
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARNING
+#endif
+
+// Records kept by LOG_EVENT for log_dump, 0 compiles the ring out
+#ifndef LOG_RING_SIZE
+#if defined(PBL_PLATFORM_APLITE)
+#define LOG_RING_SIZE 16
+#else
+#define LOG_RING_SIZE 32
+#endif
+#endif
+
+// A rate-limited call site logs at most once per this many seconds
+#define LOG_LIMIT_SECONDS 60
+
+// Per call site state for the *_LIMITED macros
+typedef struct {
+    time_t last;
+    uint16_t suppressed;
+} LogLimit;
+
+// Function declarations
+bool log_limit_pass(LogLimit *limit);
+void log_event(const char *format, int32_t a, int32_t b);
+void log_dump(void);
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) APP_LOG(APP_LOG_LEVEL_ERROR, __VA_ARGS__)
+// For errors that can repeat every frame
+#define LOG_ERROR_LIMITED(...) do { \
+        static LogLimit s_log_limit; \
+        if (log_limit_pass(&s_log_limit)) APP_LOG(APP_LOG_LEVEL_ERROR, __VA_ARGS__); \
+    } while (0)
+#else
+#define LOG_ERROR(...) do { } while (0)
+#define LOG_ERROR_LIMITED(...) do { } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARNING
+#define LOG_WARNING(...) APP_LOG(APP_LOG_LEVEL_WARNING, __VA_ARGS__)
+#else
+#define LOG_WARNING(...) do { } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) APP_LOG(APP_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) do { } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) APP_LOG(APP_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do { } while (0)
+#endif
+
+// Binary record in the RAM ring: the format string is only stored, and is
+// formatted by log_dump. It must be a string literal, or a pointer to one,
+// using at most two %ld, e.g. LOG_EVENT("Startup: first frame after %ld ms", ms, 0).
+#if LOG_RING_SIZE > 0
+#define LOG_EVENT(format, a, b) log_event(format, (int32_t)(a), (int32_t)(b))
+#else
+// Arguments are still referenced, never evaluated, so nothing goes unused
+#define LOG_EVENT(format, a, b) ((void)sizeof((a) + (b)))
+#endif
+
+#endif // LOG_H
@@ -75,9 +75,9 @@ float my_atan(float x)
         return x * (0.99997726f + x2 * (-0.33262347f + x2 * (0.19354346f + x2 *
                                         (-0.11643287f + x2 * 0.05265332f))));
     }
-    if (my_fabs(x) < 1.0f)
+    if (my_fabs(x) <= 1.0f)
     {
-        // Medium range approximation
+        // Medium range approximation (|x| == 1 must stop here, 1/x would recurse forever)
         float x2 = x * x;
         return x / (1.0f + 0.28f * x2);
     }
@@ -144,13 +144,15 @@ float my_tan(float x)
     return s / c;
 }
 
-// Fast arcsine using approximation
+// Fast arcsine (Abramowitz & Stegun 4.4.45, error under 1e-4 rad over the whole
+// domain; a plain Taylor series is off by 0.4 rad near +-1)
 float my_asin(float x)
 {
     if (my_fabs(x) > 1.0f) return 0.0f;  // Domain error
-    // Rational approximation
-    float x2 = x * x;
-    return x * (1.0f + x2 * (0.0833333333f + x2 * (0.0375f + x2 * 0.0208333333f)));
+    float a = my_fabs(x);
+    float r = M_PI_2 - my_sqrt(1.0f - a) * (1.5707288f + a * (-0.2121144f + a *
+                                           (0.0742610f - a * 0.0187293f)));
+    return (x < 0.0f) ? -r : r;
 }
 
 // Fast arccosine
@@ -0,0 +1,23 @@
+#include "moon.h"
+#include <pebble.h>
+
+// Moon phase from the mean synodic month, in whole seconds so it stays in
+// 32-bit integers on every platform (no float code pulled in on aplite).
+// The true new moon wanders up to about 14 hours either side of the mean,
+// which is well inside the 3.7 days each frame covers.
+
+// A new moon to count from: 2000-01-06 18:14 UTC
+#define MOON_EPOCH 947182440
+// 29.530588853 days
+#define MOON_SYNODIC_SECONDS 2551443
+
+// Frame index for the moon at a moment in time
+int moon_phase_frame(time_t utc) {
+    int32_t age = (int32_t)(utc - MOON_EPOCH) % MOON_SYNODIC_SECONDS;
+    if (age < 0) {
+        age += MOON_SYNODIC_SECONDS;
+    }
+    // Nearest eighth, so each frame is centred on its phase; age * 8 is at
+    // most about 20 million and can't overflow
+    return (age * MOON_FRAMES + MOON_SYNODIC_SECONDS / 2) / MOON_SYNODIC_SECONDS % MOON_FRAMES;
+}
@@ -0,0 +1,12 @@
+#ifndef MOON_H
+#define MOON_H
+
+#include <pebble.h>
+
+// Frames in moon.png, new moon first, one per eighth of the synodic month
+#define MOON_FRAMES 8
+
+// Function declarations
+int moon_phase_frame(time_t utc);
+
+#endif // MOON_H
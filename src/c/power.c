@@ -0,0 +1,76 @@
+#include "power.h"
+#include <pebble.h>
+
+// Pick the policy for the current settings and runtime conditions. Pure, so it
+// can be re-run on every battery event, settings change or schedule edge.
+PowerPolicy power_policy_select(const Settings *settings, const PowerContext *context) {
+    BatteryChargeState charge = context->charge;
+    int threshold = settings->power_saver_threshold;
+    PowerPolicyMode mode = POWER_POLICY_FULL;
+    // Plugged in, or saver disabled: no reason to hold back
+    if (threshold > 0 && !charge.is_charging && !charge.is_plugged) {
+        if (charge.charge_percent <= threshold) {
+            mode = POWER_POLICY_SAVER;
+        } else if (charge.charge_percent <= threshold * 2) {
+            mode = POWER_POLICY_ECO;
+        }
+    }
+    // With tap-to-wake the second dot only runs during a burst, and never at
+    // night or in Quiet Time
+    bool seconds_wanted = settings->show_second_dot && !context->seconds_suspended &&
+                          (!settings->tap_to_wake || context->tap_burst_active);
+    PowerPolicy policy = {
+        .mode = mode,
+        .second_dot = seconds_wanted && mode != POWER_POLICY_SAVER,
+        .smooth_sweep = seconds_wanted && settings->smooth_sweep &&
+                        mode == POWER_POLICY_FULL,
+        .live_sensor_updates = mode != POWER_POLICY_SAVER
+    };
+    // Second ticks only when the dot steps once a second; the smooth sweep
+    // paints from its own frame timer and reads the clock directly
+    policy.tick_units = MINUTE_UNIT | HOUR_UNIT | DAY_UNIT;
+    if (policy.second_dot && !policy.smooth_sweep) {
+        policy.tick_units |= SECOND_UNIT;
+    }
+    return policy;
+}
+
+// Whether second updates should be off at this hour, from the night schedule
+// and the system Quiet Time state. Checked on the minute tick.
+bool power_seconds_suspended(const Settings *settings, int hour) {
+    if (settings->night_schedule) {
+        int start = settings->night_start_hour;
+        int end = settings->night_end_hour;
+        // The window may wrap past midnight; equal hours mean an empty window
+        bool in_window = (start < end) ? (hour >= start && hour < end)
+                                       : (start > end && (hour >= start || hour < end));
+        if (in_window) {
+            return true;
+        }
+    }
+#if PBL_API_EXISTS(quiet_time_is_active)
+    if (settings->follow_quiet_time && quiet_time_is_active()) {
+        return true;
+    }
+#endif
+    return false;
+}
+
+bool power_policy_equal(const PowerPolicy *a, const PowerPolicy *b) {
+    return a->mode == b->mode && a->tick_units == b->tick_units &&
+           a->second_dot == b->second_dot && a->smooth_sweep == b->smooth_sweep &&
+           a->live_sensor_updates == b->live_sensor_updates;
+}
+
+const char *power_policy_name(PowerPolicyMode mode) {
+    switch (mode) {
+        case POWER_POLICY_FULL:
+            return "full";
+        case POWER_POLICY_ECO:
+            return "eco";
+        case POWER_POLICY_SAVER:
+            return "saver";
+        default:
+            return "unknown";
+    }
+}
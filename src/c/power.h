@@ -0,0 +1,50 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <pebble.h>
+#include "widgets.h"
+
+// Battery level (percent) below which the face drops to minute-only updates;
+// 0 disables the saver. Between this and twice this, only the sweep is dropped.
+#define DEFAULT_POWER_SAVER_THRESHOLD 20
+#define POWER_SAVER_THRESHOLD_MAX 50
+
+// Tap-to-wake: how long (seconds) a wrist tap turns per-second updates on
+#define DEFAULT_TAP_BURST_SECONDS 15
+#define TAP_BURST_SECONDS_MIN 5
+#define TAP_BURST_SECONDS_MAX 60
+
+// Night schedule for suspending second updates (hours, start inclusive)
+#define DEFAULT_NIGHT_START_HOUR 23
+#define DEFAULT_NIGHT_END_HOUR 7
+
+// Policies, from most to least power hungry
+typedef enum {
+    POWER_POLICY_FULL = 0, // Everything the settings ask for
+    POWER_POLICY_ECO,      // Per-second dot, but no smooth sweep
+    POWER_POLICY_SAVER     // Minute ticks only, sensors refresh with the minute
+} PowerPolicyMode;
+
+// Runtime conditions the policy depends on besides the settings
+typedef struct {
+    BatteryChargeState charge;
+    bool tap_burst_active;   // Within a tap-to-wake burst
+    bool seconds_suspended;  // Inside the night schedule or Quiet Time
+} PowerContext;
+
+// What the face is allowed to run under a policy
+typedef struct {
+    PowerPolicyMode mode;
+    TimeUnits tick_units;
+    bool second_dot;
+    bool smooth_sweep;
+    bool live_sensor_updates; // Repaint on every health event, not just each minute
+} PowerPolicy;
+
+// Function declarations
+PowerPolicy power_policy_select(const Settings *settings, const PowerContext *context);
+bool power_seconds_suspended(const Settings *settings, int hour);
+bool power_policy_equal(const PowerPolicy *a, const PowerPolicy *b);
+const char *power_policy_name(PowerPolicyMode mode);
+
+#endif // POWER_H
@@ -0,0 +1,154 @@
+#include "sparkline.h"
+#include <pebble.h>
+#include "glyphs.auto.h"
+#include "invalidate.h"
+
+// Steps per hour for the last SPARKLINE_HOURS completed hours, pre-rendered
+// into a small 1-bit bitmap that is only redrawn when a bucket changes.
+// Aplite has neither minute history nor palettized 1-bit bitmaps, so the
+// widget stays empty there.
+
+#define SPARKLINE_WIDTH BAR_WIDTH
+#define SPARKLINE_HEIGHT BAR_HEIGHT
+#define SPARKLINE_PITCH (SPARKLINE_WIDTH / SPARKLINE_HOURS) // Column pitch, 1px gap included
+
+#if !defined(PBL_PLATFORM_APLITE)
+static uint16_t s_buckets[SPARKLINE_HOURS]; // Ring, oldest at s_head
+static int s_head = 0;
+static time_t s_last_hour = 0;  // Start of the hour after the newest bucket
+static GBitmap *s_bitmap = NULL;
+static GColor s_palette[2];
+
+// Start of the current hour in local time
+static time_t current_hour_start(void) {
+    time_t now = time(NULL);
+    struct tm *local = localtime(&now);
+    return now - local->tm_min * SECONDS_PER_MINUTE - local->tm_sec;
+}
+
+// Steps recorded in one hour of minute history
+static uint16_t hour_steps(HealthMinuteData *minutes, time_t start) {
+    time_t end = start + SECONDS_PER_HOUR;
+    uint32_t count = health_service_get_minute_history(minutes, 60, &start, &end);
+    uint32_t steps = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (!minutes[i].is_invalid) {
+            steps += minutes[i].steps;
+        }
+    }
+    return steps < UINT16_MAX ? (uint16_t)steps : UINT16_MAX;
+}
+
+// Redraw the cached bitmap from the buckets: one bar per hour, oldest on the left
+static void render(void) {
+    uint8_t *data = gbitmap_get_data(s_bitmap);
+    uint16_t stride = gbitmap_get_bytes_per_row(s_bitmap);
+    memset(data, 0, stride * SPARKLINE_HEIGHT);
+    uint16_t max = 0;
+    for (int i = 0; i < SPARKLINE_HOURS; i++) {
+        if (s_buckets[i] > max) max = s_buckets[i];
+    }
+    if (max == 0) return;
+    int left = SPARKLINE_WIDTH - SPARKLINE_HOURS * SPARKLINE_PITCH;
+    for (int i = 0; i < SPARKLINE_HOURS; i++) {
+        uint16_t steps = s_buckets[(s_head + i) % SPARKLINE_HOURS];
+        int height = steps * SPARKLINE_HEIGHT / max;
+        if (steps > 0 && height == 0) height = 1;
+        int x0 = left + i * SPARKLINE_PITCH;
+        for (int y = SPARKLINE_HEIGHT - height; y < SPARKLINE_HEIGHT; y++) {
+            uint8_t *row = data + y * stride;
+            for (int x = x0; x < x0 + SPARKLINE_PITCH - 1; x++) {
+                // Palettized 1-bit rows are packed most significant bit first
+                row[x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+    }
+}
+#endif
+
+// Allocate the bitmap and fill the buckets from minute history, once
+void sparkline_init(bool dark_mode) {
+#if !defined(PBL_PLATFORM_APLITE)
+    if (s_bitmap) return;
+    s_bitmap = gbitmap_create_blank(GSize(SPARKLINE_WIDTH, SPARKLINE_HEIGHT),
+                                    GBitmapFormat1BitPalette);
+    if (!s_bitmap) return;
+    sparkline_set_dark_mode(dark_mode);
+    memset(s_buckets, 0, sizeof(s_buckets));
+    s_head = 0;
+    s_last_hour = current_hour_start();
+    time_t first = s_last_hour - SPARKLINE_HOURS * SECONDS_PER_HOUR;
+    if (health_service_metric_accessible(HealthMetricStepCount, first, s_last_hour) &
+        HealthServiceAccessibilityMaskAvailable) {
+        HealthMinuteData *minutes = malloc(60 * sizeof(HealthMinuteData));
+        if (minutes) {
+            for (int i = 0; i < SPARKLINE_HOURS; i++) {
+                s_buckets[i] = hour_steps(minutes, first + i * SECONDS_PER_HOUR);
+            }
+            free(minutes);
+        }
+    }
+    render();
+#endif
+}
+
+void sparkline_deinit(void) {
+#if !defined(PBL_PLATFORM_APLITE)
+    if (s_bitmap) {
+        gbitmap_destroy(s_bitmap);
+        s_bitmap = NULL;
+    }
+#endif
+}
+
+bool sparkline_active(void) {
+#if !defined(PBL_PLATFORM_APLITE)
+    return s_bitmap != NULL;
+#else
+    return false;
+#endif
+}
+
+// Append the hour that just finished, dropping the oldest
+void sparkline_hour_tick(void) {
+#if !defined(PBL_PLATFORM_APLITE)
+    if (!s_bitmap) return;
+    time_t hour = current_hour_start();
+    if (hour == s_last_hour) return;
+    HealthMinuteData *minutes = malloc(60 * sizeof(HealthMinuteData));
+    if (!minutes) return;
+    // Normally one bucket; more if hour ticks were missed
+    bool changed = false;
+    for (int i = 0; i < SPARKLINE_HOURS && s_last_hour < hour; i++) {
+        s_buckets[s_head] = hour_steps(minutes, s_last_hour);
+        s_head = (s_head + 1) % SPARKLINE_HOURS;
+        s_last_hour += SECONDS_PER_HOUR;
+        changed = true;
+    }
+    s_last_hour = hour;
+    free(minutes);
+    if (changed) {
+        render();
+    }
+#endif
+}
+
+// Bars in the foreground colour, background transparent
+void sparkline_set_dark_mode(bool dark_mode) {
+#if !defined(PBL_PLATFORM_APLITE)
+    s_palette[0] = GColorClear;
+    s_palette[1] = dark_mode ? GColorWhite : GColorBlack;
+    if (s_bitmap) {
+        gbitmap_set_palette(s_bitmap, s_palette, false);
+    }
+#endif
+}
+
+void sparkline_draw(GContext *ctx, int x, int y) {
+#if !defined(PBL_PLATFORM_APLITE)
+    if (!s_bitmap) return;
+    graphics_context_set_compositing_mode(ctx, GCompOpSet);
+    graphics_draw_bitmap_in_rect(ctx, s_bitmap, GRect(x, y, SPARKLINE_WIDTH, SPARKLINE_HEIGHT));
+    INVALIDATE_COUNT_PAINTED(SPARKLINE_WIDTH, SPARKLINE_HEIGHT);
+#endif
+}
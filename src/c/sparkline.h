@@ -0,0 +1,17 @@
+#ifndef SPARKLINE_H
+#define SPARKLINE_H
+
+#include <pebble.h>
+
+// Hourly step buckets shown by the sparkline widget
+#define SPARKLINE_HOURS 12
+
+// Function declarations
+void sparkline_init(bool dark_mode);
+void sparkline_deinit(void);
+bool sparkline_active(void);
+void sparkline_hour_tick(void);
+void sparkline_set_dark_mode(bool dark_mode);
+void sparkline_draw(GContext *ctx, int x, int y);
+
+#endif // SPARKLINE_H
@@ -0,0 +1,78 @@
+#include "sun.h"
+#include <pebble.h>
+#include "math.h"
+
+// Sunrise and sunset from the NOAA low-accuracy equations, using the fast
+// trig in math.c. Run at most once a day; the result is kept in persist so a
+// restart doesn't recompute it.
+
+#define SUN_PERSIST_KEY 2
+#define DEG_TO_RAD (M_PI / 180.0f)
+#define RAD_TO_DEG (180.0f / M_PI)
+#define SUN_ALTITUDE_DEG (-0.833f) // Upper limb on the horizon, with refraction
+#define MINUTES_PER_DAY (24 * 60)
+
+static SunTimes s_times;
+static bool s_times_loaded = false;
+
+static int wrap_minutes(int minutes) {
+    minutes %= MINUTES_PER_DAY;
+    return minutes < 0 ? minutes + MINUTES_PER_DAY : minutes;
+}
+
+static int32_t day_key(const struct tm *local) {
+    return (local->tm_year + 1900) * 1000 + local->tm_yday;
+}
+
+void sun_compute(SunTimes *times, int32_t latitude_e2, int32_t longitude_e2,
+                 const struct tm *local) {
+    times->day = day_key(local);
+    times->latitude_e2 = latitude_e2;
+    times->longitude_e2 = longitude_e2;
+    times->utc_offset = local->tm_gmtoff;
+    times->sunrise = SUN_NONE;
+    times->sunset = SUN_NONE;
+
+    float latitude = latitude_e2 / 100.0f * DEG_TO_RAD;
+    float longitude = longitude_e2 / 100.0f;
+    // Fractional year (radians) at noon, then the solar declination and the
+    // equation of time (minutes) from their Fourier series
+    float g = 2.0f * M_PI / 365.0f * local->tm_yday;
+    float declination = 0.006918f - 0.399912f * my_cos(g) + 0.070257f * my_sin(g) -
+                        0.006758f * my_cos(2.0f * g) + 0.000907f * my_sin(2.0f * g) -
+                        0.002697f * my_cos(3.0f * g) + 0.00148f * my_sin(3.0f * g);
+    float equation_of_time = 229.18f * (0.000075f + 0.001868f * my_cos(g) - 0.032077f * my_sin(g) -
+                                        0.014615f * my_cos(2.0f * g) - 0.040849f * my_sin(2.0f * g));
+    // Hour angle between solar noon and the sun crossing the horizon
+    float cos_hour_angle = (my_sin(SUN_ALTITUDE_DEG * DEG_TO_RAD) -
+                            my_sin(latitude) * my_sin(declination)) /
+                           (my_cos(latitude) * my_cos(declination));
+    if (cos_hour_angle > 1.0f || cos_hour_angle < -1.0f) {
+        // Polar night or midnight sun
+        return;
+    }
+    float hour_angle = my_acos(cos_hour_angle) * RAD_TO_DEG;
+    // Solar noon in minutes after local midnight; the sun moves 4 minutes per degree
+    float noon = 720.0f - 4.0f * longitude - equation_of_time + local->tm_gmtoff / 60.0f;
+    times->sunrise = wrap_minutes((int)my_rint(noon - 4.0f * hour_angle));
+    times->sunset = wrap_minutes((int)my_rint(noon + 4.0f * hour_angle));
+}
+
+// Today's times, from memory, persist or (once a day) a fresh computation
+const SunTimes *sun_times_for_day(int32_t latitude_e2, int32_t longitude_e2,
+                                  const struct tm *local) {
+    if (latitude_e2 == SUN_NO_LOCATION || longitude_e2 == SUN_NO_LOCATION) return NULL;
+    if (!s_times_loaded) {
+        s_times_loaded = true;
+        if (!persist_exists(SUN_PERSIST_KEY) ||
+            persist_read_data(SUN_PERSIST_KEY, &s_times, sizeof(s_times)) != (int)sizeof(s_times)) {
+            memset(&s_times, 0, sizeof(s_times));
+        }
+    }
+    if (s_times.day != day_key(local) || s_times.latitude_e2 != latitude_e2 ||
+        s_times.longitude_e2 != longitude_e2 || s_times.utc_offset != local->tm_gmtoff) {
+        sun_compute(&s_times, latitude_e2, longitude_e2, local);
+        persist_write_data(SUN_PERSIST_KEY, &s_times, sizeof(s_times));
+    }
+    return &s_times;
+}
@@ -0,0 +1,27 @@
+#ifndef SUN_H
+#define SUN_H
+
+#include <pebble.h>
+
+// Location as sent from the phone, in hundredths of a degree
+#define SUN_NO_LOCATION INT32_MIN
+
+// Sunrise and sunset for one day, in minutes after local midnight
+#define SUN_NONE (-1) // Sun never rises or never sets that day
+
+typedef struct {
+    int32_t day;          // year * 1000 + day of year the times are for
+    int32_t latitude_e2;
+    int32_t longitude_e2;
+    int32_t utc_offset;   // Seconds east of UTC the times were computed with
+    int16_t sunrise;
+    int16_t sunset;
+} SunTimes;
+
+// Function declarations
+void sun_compute(SunTimes *times, int32_t latitude_e2, int32_t longitude_e2,
+                 const struct tm *local);
+const SunTimes *sun_times_for_day(int32_t latitude_e2, int32_t longitude_e2,
+                                  const struct tm *local);
+
+#endif // SUN_H
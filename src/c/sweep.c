@@ -0,0 +1,111 @@
+#include "sweep.h"
+#include <pebble.h>
+#include "invalidate.h"
+
+// Sub-second progress is kept in 1/1024ths so interpolation is a shift
+#define SWEEP_FRAC_BITS 10
+
+static bool s_running = false;
+static AppTimer *s_sweep_timer = NULL;
+static uint16_t s_frame_interval_ms = 0; // Period asked for by the FPS cap
+static uint16_t s_interval_ms = 0;       // Period in use, stretched if frames run long
+static uint32_t s_frame_start_ms = 0;
+static SweepStats s_stats;
+
+// Milliseconds since the epoch, wrapped; only used for short differences
+static uint32_t now_ms(void) {
+    time_t seconds;
+    uint16_t millis;
+    time_ms(&seconds, &millis);
+    return (uint32_t)seconds * 1000 + millis;
+}
+
+// Wait until the next multiple of the interval within the current second.
+// Frames line up with whole seconds only when the interval divides 1000;
+// otherwise the last frame of each second is shorter.
+static uint32_t next_frame_delay(void) {
+    uint16_t millis;
+    time_ms(NULL, &millis);
+    return s_interval_ms - (millis % s_interval_ms);
+}
+
+static void sweep_timer_callback(void *data) {
+    s_sweep_timer = NULL;
+    if (!s_running) return;
+    invalidate_post(INVALIDATE_SWEEP);
+    s_sweep_timer = app_timer_register(next_frame_delay(), sweep_timer_callback, NULL);
+}
+
+// Start requesting repaints at up to fps frames per second
+void sweep_start(int fps) {
+    if (fps < SWEEP_FPS_MIN) fps = SWEEP_FPS_MIN;
+    if (fps > SWEEP_FPS_MAX) fps = SWEEP_FPS_MAX;
+    s_running = true;
+    s_frame_interval_ms = 1000 / fps;
+    s_interval_ms = s_frame_interval_ms;
+    memset(&s_stats, 0, sizeof(s_stats));
+    if (s_sweep_timer) {
+        app_timer_cancel(s_sweep_timer);
+    }
+    s_sweep_timer = app_timer_register(next_frame_delay(), sweep_timer_callback, NULL);
+}
+
+void sweep_stop(void) {
+    if (s_sweep_timer) {
+        app_timer_cancel(s_sweep_timer);
+        s_sweep_timer = NULL;
+    }
+    s_running = false;
+}
+
+bool sweep_running(void) {
+    return s_running;
+}
+
+// Second dot position for this instant, between two neighbouring ring points
+GPoint sweep_position(const FaceLayout *layout, int *second_out) {
+    time_t seconds;
+    uint16_t millis;
+    time_ms(&seconds, &millis);
+    int second = (int)(seconds % RING_POSITIONS);
+    int32_t frac = ((int32_t)millis << SWEEP_FRAC_BITS) / 1000;
+    GPoint from = layout->ring[second];
+    GPoint to = layout->ring[(second + 1) % RING_POSITIONS];
+    if (second_out) {
+        *second_out = second;
+    }
+    return GPoint(from.x + (((to.x - from.x) * frac) >> SWEEP_FRAC_BITS),
+                  from.y + (((to.y - from.y) * frac) >> SWEEP_FRAC_BITS));
+}
+
+// Bracket the layer's update proc to measure the per-frame draw cost
+void sweep_frame_begin(void) {
+    s_frame_start_ms = now_ms();
+}
+
+void sweep_frame_end(void) {
+    if (!sweep_running()) return;
+    uint16_t cost = (uint16_t)(now_ms() - s_frame_start_ms);
+    s_stats.frames++;
+    if (cost > s_stats.max_cost_ms) {
+        s_stats.max_cost_ms = cost;
+    }
+    uint16_t budget = s_interval_ms * SWEEP_FRAME_BUDGET_PERCENT / 100;
+    if (cost > budget) {
+        // Over budget: stretch the period so the draw fits in it again
+        s_stats.over_budget++;
+        uint32_t stretched = (uint32_t)cost * 100 / SWEEP_FRAME_BUDGET_PERCENT;
+        s_interval_ms = stretched < 1000 ? stretched : 1000;
+    } else if (s_interval_ms > s_frame_interval_ms && cost * 2 < budget) {
+        // Comfortably under: creep back towards the requested rate
+        s_interval_ms -= (s_interval_ms - s_frame_interval_ms + 1) / 2;
+    }
+}
+
+// Read and reset the counters
+SweepStats sweep_take_stats(void) {
+    SweepStats stats = s_stats;
+    stats.interval_ms = s_interval_ms;
+    memset(&s_stats, 0, sizeof(s_stats));
+    return stats;
+}
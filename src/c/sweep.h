@@ -0,0 +1,33 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <pebble.h>
+#include "layout.h"
+
+// Frame rates offered in the settings page
+#define SWEEP_FPS_MIN 1
+#define SWEEP_FPS_MAX 30
+#define DEFAULT_SWEEP_FPS 10
+
+// Never let a frame's draw take more than this share of the frame period;
+// slower frames stretch the period so the event loop always gets idle time
+#define SWEEP_FRAME_BUDGET_PERCENT 50
+
+// Frame counters, for measuring what the sweep costs
+typedef struct {
+    uint32_t frames;        // Frames drawn since the last reset
+    uint32_t over_budget;   // Frames whose draw exceeded the budget
+    uint16_t interval_ms;   // Current frame period, after any stretching
+    uint16_t max_cost_ms;   // Slowest draw since the last reset
+} SweepStats;
+
+// Function declarations
+void sweep_start(int fps);
+void sweep_stop(void);
+bool sweep_running(void);
+GPoint sweep_position(const FaceLayout *layout, int *second_out);
+void sweep_frame_begin(void);
+void sweep_frame_end(void);
+SweepStats sweep_take_stats(void);
+
+#endif // SWEEP_H
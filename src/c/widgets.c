@@ -1,5 +1,13 @@
 #include "widgets.h"
 #include <pebble.h>
+#include "font.h"
+#include "invalidate.h"
+#include "log.h"
+#include "sparkline.h"
+#include "sun.h"
+#include "moon.h"
+#include "battery_history.h"
+#include "../common/worker_protocol.h"
 
 // Global widget configuration
 static WidgetConfig s_widget_config = {
@@ -14,12 +22,81 @@ static int s_step_goal = 10000; // Default step goal
 
 // Health service state tracking
 static bool s_health_services_available = false;
+// Once the background worker reports steps, it owns the health subscription
+static bool s_worker_feeds_steps = false;
+// Hours of battery left from the discharge trend in battery_history.c, as
+// text; empty while unknown. Only recomputed when a sample is added.
+static char s_battery_hours_text[3] = "";
+static bool s_health_subscribed = false;
+
+// Heart rate, and the sampling period we asked for while it is on screen
+static int s_heart_rate_bpm = 0; // 0 = no reading
+static int s_heart_rate_period = 0; // Requested period in seconds, 0 = system default
+static bool s_heart_rate_period_active = false;
+// Repaint on each health event; off when the power policy batches them per minute
+static bool s_live_sensor_updates = true;
+
+// Anyone else interested in battery events (there is only one subscription)
+static BatteryStateHandler s_battery_listener = NULL;
 
 // Sprite sheets
-static GBitmap *s_battery_sprites = NULL;
-static GBitmap *s_steps_sprites = NULL;
-static GBitmap *s_date_sprites = NULL;
-static GBitmap *s_am_pm_indicator = NULL;
+static Font s_battery_font;
+static Font s_steps_font;
+static Font s_date_font;
+static Font s_am_pm_font;
+static Font s_mini_font;
+static Font s_moon_font;
+static Font s_connection_font;
+
+// Phone connection, kept up to date by connection service events while the
+// connection widget is shown; drawing never queries the service
+static bool s_connected = false;
+static bool s_connection_subscribed = false;
+
+// Moon phase frame for today, worked out once a day
+static int s_moon_frame = 0;
+
+// An H:MM or HH:MM in the mini digits, formatted and measured once so
+// drawing is only the blits
+typedef struct {
+    char hour_text[3];
+    char minute_text[3];
+    int width; // 0 = nothing to show
+} MiniTime;
+
+// Location for the sun widget and its next sunrise or sunset, formatted on
+// the minute tick so drawing never touches the sun math
+static int32_t s_latitude_e2 = SUN_NO_LOCATION;
+static int32_t s_longitude_e2 = SUN_NO_LOCATION;
+static const SunTimes *s_sun_times = NULL; // Today's times, NULL without a location
+static MiniTime s_sun_time;
+
+// Second time zone: minutes east of UTC and the time there, formatted on the
+// minute tick from the local time that tick already carries
+static int s_second_tz_offset = 0;
+static MiniTime s_second_tz_time;
+
+// Last-known sensor values, saved on exit so the first frames after a
+// restart show them instead of empty widgets while the sensors catch up
+#define WIDGETS_CACHE_KEY 3
+
+typedef struct {
+    int32_t day;              // year * 1000 + day of year the step count is for
+    int32_t step_count;
+    uint8_t battery_percent;
+} WidgetsCache;
+
+// Widget sprite frames (battery.png/steps.png are single-column frame strips)
+#define BATTERY_FRAMES 10
+#define STEPS_FRAMES 9
+#define DATE_SPACING GLYPH_SCALE(4)
+#define MINI_SPACING GLYPH_SCALE(2)
+// Colon between mini digit pairs, in the 2px blocks the mini digits are drawn with
+#define MINI_COLON_WIDTH GLYPH_SCALE(6)
+#define MINI_COLON_DOT_X GLYPH_SCALE(2)
+#define MINI_COLON_DOT_SIZE GLYPH_SCALE(2)
+#define MINI_COLON_TOP_Y GLYPH_SCALE(1)
+#define MINI_COLON_BOTTOM_Y GLYPH_SCALE(5)
 
 // External settings (these will be linked from the main file)
 extern bool s_settings_use_24_hour_format;
@@ -57,18 +134,51 @@ static void invert_bitmap_palette(GBitmap *bitmap) {
     }
 }
 
+// Hours left from the battery history, capped to the two digits drawn
+static void update_battery_hours_text(void) {
+    int hours = battery_history_hours_left();
+    if (hours >= 0) {
+        snprintf(s_battery_hours_text, sizeof(s_battery_hours_text), "%d", hours < 99 ? hours : 99);
+    } else {
+        s_battery_hours_text[0] = '\0';
+    }
+}
+
 // Battery state handler
 static void battery_state_handler(BatteryChargeState charge_state) {
     s_battery_percent = charge_state.charge_percent;
-    // Force redraw to update battery indicator
-    Layer *root_layer = window_get_root_layer(window_stack_get_top_window());
-    if (root_layer) {
-        layer_mark_dirty(root_layer);
+    if (battery_history_update(charge_state)) {
+        update_battery_hours_text();
+    }
+    if (s_battery_listener) {
+        s_battery_listener(charge_state);
+    }
+    // Redraw to update battery indicator
+    invalidate_post(INVALIDATE_BATTERY);
+}
+
+// Latest heart rate reading, if the sensor has one
+static void update_heart_rate(void) {
+    time_t now = time(NULL);
+    if (health_service_metric_accessible(HealthMetricHeartRateBPM, now, now) &
+        HealthServiceAccessibilityMaskAvailable) {
+        s_heart_rate_bpm = (int)health_service_peek_current_value(HealthMetricHeartRateBPM);
+    } else {
+        s_heart_rate_bpm = 0;
     }
 }
 
 // Health event handler
 static void health_event_handler(HealthEventType event, void *context) {
+    if (event == HealthEventHeartRateUpdate) {
+        update_heart_rate();
+        if (s_live_sensor_updates) {
+            invalidate_post(INVALIDATE_HEART_RATE);
+        }
+        return;
+    }
+    // The background worker owns the step count once it reports one
+    if (s_worker_feeds_steps) return;
     if (event == HealthEventSignificantUpdate || event == HealthEventMovementUpdate) {
         // Update step count for current day using Pebble SDK's time_start_of_today()
         time_t start = time_start_of_today();
@@ -77,97 +187,157 @@ static void health_event_handler(HealthEventType event, void *context) {
         // Get steps for current day only
         HealthValue steps = health_service_sum(HealthMetricStepCount, start, end);
         s_step_count = (int)steps;
-        
-        // Force redraw to update step counter
-        Layer *root_layer = window_get_root_layer(window_stack_get_top_window());
-        if (root_layer) {
-            layer_mark_dirty(root_layer);
+        // In power saver the new count shows with the next minute tick
+        if (!s_live_sensor_updates) {
+            return;
         }
+        
+        // Redraw to update step counter
+        invalidate_post(INVALIDATE_STEPS);
     }
 }
 
-// Function to draw a date number (digits from date.png)
-static void draw_date_number(GContext *ctx, int digit, int x, int y) {
-    // Validate sprite sheet exists
-    if (!s_date_sprites) {
-        APP_LOG(APP_LOG_LEVEL_ERROR, "Date sprite sheet is NULL");
-        return;
-    }
-    // Validate sprite sheet bounds
-    GSize sprite_sheet_size = gbitmap_get_bounds(s_date_sprites).size;
-    if (sprite_sheet_size.w <= 0 || sprite_sheet_size.h <= 0) {
-        APP_LOG(APP_LOG_LEVEL_ERROR, "Invalid date sprite sheet dimensions: %dx%d",
-                sprite_sheet_size.w, sprite_sheet_size.h);
-        return;
-    }
-    // Map digit to sprite position in the 3x4 grid
-    // Layout: 1,2,3,4,5,6,7,8,9,0
-    int sprite_index = -1;
-    switch (digit) {
-        case 1: sprite_index = 0; break;
-        case 2: sprite_index = 1; break;
-        case 3: sprite_index = 2; break;
-        case 4: sprite_index = 3; break;
-        case 5: sprite_index = 4; break;
-        case 6: sprite_index = 5; break;
-        case 7: sprite_index = 6; break;
-        case 8: sprite_index = 7; break;
-        case 9: sprite_index = 8; break;
-        case 0: sprite_index = 9; break;
-        default:
-            APP_LOG(APP_LOG_LEVEL_ERROR, "Unknown date digit: %d", digit);
-            return;
+// Whether a widget is in either corner
+static bool widget_selected(WidgetType type) {
+    return s_widget_config.top_left_widget == type || s_widget_config.top_right_widget == type;
+}
+
+// Which sheet each widget draws with
+#define WIDGET_BIT(type) (1u << (type))
+
+typedef struct {
+    Font *font;
+    uint32_t resource_id;
+    const uint8_t *lookup;
+    GSize cell;
+    uint8_t per_row;
+    uint8_t glyph_count;
+    int8_t spacing;
+    uint16_t widgets; // WIDGET_BIT of every widget that draws with it
+} WidgetSheet;
+
+static const WidgetSheet s_widget_sheets[] = {
+    { &s_battery_font, RESOURCE_ID_BATTERY, NULL, { BAR_WIDTH, BAR_HEIGHT },
+      1, BATTERY_FRAMES, 0, WIDGET_BIT(WIDGET_BATTERY_INDICATOR) | WIDGET_BIT(WIDGET_BATTERY_TIME) },
+    { &s_steps_font, RESOURCE_ID_STEPS, NULL, { BAR_WIDTH, BAR_HEIGHT },
+      1, STEPS_FRAMES, 0, WIDGET_BIT(WIDGET_STEP_COUNT) },
+    { &s_date_font, RESOURCE_ID_DATE_SPRITES, FONT_LOOKUP_DIGITS, { DATE_WIDTH, DATE_HEIGHT },
+      DATE_SPRITES_PER_ROW, 10, DATE_SPACING,
+      WIDGET_BIT(WIDGET_MONTH_DATE) | WIDGET_BIT(WIDGET_DAY_DATE) |
+      WIDGET_BIT(WIDGET_HEART_RATE) | WIDGET_BIT(WIDGET_BATTERY_TIME) },
+    { &s_am_pm_font, RESOURCE_ID_AM_PM_INDICATOR, FONT_LOOKUP_AM_PM, { AM_PM_WIDTH, AM_PM_HEIGHT },
+      1, 2, 0, WIDGET_BIT(WIDGET_AM_PM_INDICATOR) },
+    { &s_mini_font, RESOURCE_ID_MINI_DIGIT, FONT_LOOKUP_DIGITS, { MINI_WIDTH, MINI_HEIGHT },
+      MINI_SPRITES_PER_ROW, 10, MINI_SPACING,
+      WIDGET_BIT(WIDGET_SUN_TIMES) | WIDGET_BIT(WIDGET_SECOND_TZ) },
+    { &s_moon_font, RESOURCE_ID_MOON, NULL, { MOON_SIZE, MOON_SIZE },
+      1, MOON_FRAMES, 0, WIDGET_BIT(WIDGET_MOON_PHASE) },
+    { &s_connection_font, RESOURCE_ID_CONNECTION, NULL, { CONNECTION_WIDTH, CONNECTION_HEIGHT },
+      1, 2, 0, WIDGET_BIT(WIDGET_CONNECTION) }
+};
+
+#define WIDGET_SHEET_COUNT (sizeof(s_widget_sheets) / sizeof(s_widget_sheets[0]))
+
+// WIDGET_BIT for a configured widget; a value from a bad settings message
+// matches no sheet
+static uint32_t widget_bit(WidgetType type) {
+    return ((unsigned)type < 16) ? WIDGET_BIT(type) : 0;
+}
+
+// Widgets drawn purely from what widgets_restore_cache brings back, so they
+// can be on the first frame before any sensor is read
+#define WIDGETS_FROM_CACHE (WIDGET_BIT(WIDGET_BATTERY_INDICATOR) | WIDGET_BIT(WIDGET_STEP_COUNT))
+#define WIDGETS_ALL 0xFFFFu
+
+// Load the sheets the two corner widgets draw with (of those in the mask), in
+// the palette for the current dark mode setting, and release the rest so
+// unused widgets cost no heap. Sheets already loaded are kept unless reload
+// is set.
+static void load_widget_fonts(bool reload, uint32_t mask) {
+    uint32_t shown = (widget_bit(s_widget_config.top_left_widget) |
+                      widget_bit(s_widget_config.top_right_widget)) & mask;
+    for (size_t i = 0; i < WIDGET_SHEET_COUNT; i++) {
+        const WidgetSheet *sheet = &s_widget_sheets[i];
+        if (!(sheet->widgets & shown)) {
+            font_unload(sheet->font);
+            continue;
+        }
+        if (sheet->font->sheet && !reload) {
+            continue;
+        }
+        font_load(sheet->font, sheet->resource_id, sheet->lookup, sheet->cell,
+                  sheet->per_row, sheet->glyph_count, sheet->spacing);
+        // Invert palette colors for dark mode if enabled
+        if (s_settings_dark_mode) {
+            invert_bitmap_palette(sheet->font->sheet);
+        }
     }
-    // Calculate sprite position in the spritesheet
-    int sprite_row = sprite_index / DATE_SPRITES_PER_ROW;
-    int sprite_col = sprite_index % DATE_SPRITES_PER_ROW;
-    // Validate sprite position is within bounds
-    int max_col = sprite_sheet_size.w / DATE_WIDTH;
-    int max_row = sprite_sheet_size.h / DATE_HEIGHT;
-    if (sprite_col >= max_col || sprite_row >= max_row) {
-        APP_LOG(APP_LOG_LEVEL_ERROR,
-                "Date sprite position out of bounds: digit=%d, row=%d/%d, col=%d/%d",
-                digit, sprite_row, max_row, sprite_col, max_col);
-        return;
+}
+
+// Release widget sprite sheets
+static void unload_widget_fonts(void) {
+    for (size_t i = 0; i < WIDGET_SHEET_COUNT; i++) {
+        font_unload(s_widget_sheets[i].font);
     }
-    // Calculate source rectangle in the spritesheet
-    GRect source_rect = GRect(
-                            sprite_col * DATE_WIDTH,
-                            sprite_row * DATE_HEIGHT,
-                            DATE_WIDTH,
-                            DATE_HEIGHT
-                        );
-    // Calculate destination position
-    GRect dest_rect = GRect(x, y, DATE_WIDTH, DATE_HEIGHT);
-    // Set compositing mode for transparency
-    graphics_context_set_compositing_mode(ctx, GCompOpSet);
-    // Create a sub-bitmap for the specific sprite
-    GBitmap *digit_bitmap = gbitmap_create_as_sub_bitmap(s_date_sprites, source_rect);
-    if (!digit_bitmap) {
-        APP_LOG(APP_LOG_LEVEL_ERROR, "Failed to create sub-bitmap for date digit %d", digit);
-        return;
+}
+
+// Ask for the configured HR sampling period while the widget is shown, and
+// hand the sensor back to the system default as soon as it is not
+static void update_heart_rate_sampling(void) {
+#if PBL_API_EXISTS(health_service_set_heart_rate_sample_period)
+    // Power saver leaves sampling to the system too
+    bool want = widget_selected(WIDGET_HEART_RATE) && s_heart_rate_period > 0 &&
+                s_live_sensor_updates;
+    if (want) {
+        health_service_set_heart_rate_sample_period(s_heart_rate_period);
+    } else if (s_heart_rate_period_active) {
+        health_service_set_heart_rate_sample_period(0);
+    }
+    s_heart_rate_period_active = want;
+#endif
+}
+
+// Subscribe to health events while a widget needs them
+static void update_health_subscription(void) {
+    bool want_steps = widget_selected(WIDGET_STEP_COUNT) && !s_worker_feeds_steps;
+    bool want_heart_rate = widget_selected(WIDGET_HEART_RATE);
+    
+    if ((want_steps || want_heart_rate) && PBL_PLATFORM_TYPE_CURRENT != PlatformTypeAplite) {
+        // When a health widget is enabled via config change, try to subscribe to health services
+        // This allows detection of when health services become available after being disabled
+        bool subscription_success = health_service_events_subscribe(health_event_handler, NULL);
+        s_health_subscribed = subscription_success;
+        
+        if (subscription_success) {
+            if (want_steps) {
+                // Health services are available, get current step count
+                time_t start = time_start_of_today();
+                time_t end = start + SECONDS_PER_DAY - 1;
+                HealthValue steps = health_service_sum(HealthMetricStepCount, start, end);
+                s_step_count = (int)steps;
+            }
+            if (want_heart_rate) {
+                update_heart_rate();
+            }
+            LOG_DEBUG("Health services available - %d steps, %d bpm", s_step_count, s_heart_rate_bpm);
+        } else {
+            // Health services not available, show the empty state
+            if (want_steps) {
+                s_step_count = 0;
+            }
+            s_heart_rate_bpm = 0;
+            LOG_DEBUG("Health services not available - health widgets show empty state");
+        }
+    } else if (s_health_subscribed) {
+        health_service_events_unsubscribe();
+        s_health_subscribed = false;
     }
-    // Draw the sprite
-    graphics_draw_bitmap_in_rect(ctx, digit_bitmap, dest_rect);
-    // Clean up the sub-bitmap
-    gbitmap_destroy(digit_bitmap);
+    update_heart_rate_sampling();
 }
 
 // Initialize widget system
 void widgets_init(void) {
-    // Load sprite sheets
-    s_battery_sprites = gbitmap_create_with_resource(RESOURCE_ID_BATTERY);
-    s_steps_sprites = gbitmap_create_with_resource(RESOURCE_ID_STEPS);
-    s_date_sprites = gbitmap_create_with_resource(RESOURCE_ID_DATE_SPRITES);
-    s_am_pm_indicator = gbitmap_create_with_resource(RESOURCE_ID_AM_PM_INDICATOR);
-    
-    // Invert palette colors for dark mode if enabled
-    if (s_settings_dark_mode) {
-        invert_bitmap_palette(s_battery_sprites);
-        invert_bitmap_palette(s_steps_sprites);
-        invert_bitmap_palette(s_date_sprites);
-        invert_bitmap_palette(s_am_pm_indicator);
-    }
+    // Sprite sheets follow in widgets_set_config, for the widgets actually shown
     
     // Subscribe to battery state updates
     battery_state_service_subscribe(battery_state_handler);
@@ -175,187 +345,292 @@ void widgets_init(void) {
     
     // Conservative approach: Never subscribe to health services to prevent pop-ups
     // We cannot safely test subscription without causing pop-ups, so we assume
-    // health services are disabled and show empty state to avoid annoying users
+    // health services are disabled and show the cached count (or the empty
+    // state) to avoid annoying users
     bool step_counter_selected = (s_widget_config.top_left_widget == WIDGET_STEP_COUNT || 
                                  s_widget_config.top_right_widget == WIDGET_STEP_COUNT);
     
     if (step_counter_selected && PBL_PLATFORM_TYPE_CURRENT != PlatformTypeAplite) {
         // Step counter is selected but we won't subscribe to health services
         // to prevent pop-ups when health services are disabled
-        s_step_count = 0;
-        if (s_settings_debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "Step counter selected but health services not subscribed to prevent pop-ups");
-        }
+        LOG_DEBUG("Step counter selected but health services not subscribed to prevent pop-ups");
     } else {
         // Step counter not selected or on Aplite platform
-        s_step_count = 0;
-        if (s_settings_debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "Step counter disabled or Aplite platform");
-        }
+        LOG_DEBUG("Step counter disabled or Aplite platform");
     }
 }
 
-// Reload widget sprites (for dark mode changes)
-void widgets_reload_sprites(void) {
-    // Clean up existing sprite sheets
-    if (s_battery_sprites) {
-        gbitmap_destroy(s_battery_sprites);
-        s_battery_sprites = NULL;
-    }
-    if (s_steps_sprites) {
-        gbitmap_destroy(s_steps_sprites);
-        s_steps_sprites = NULL;
-    }
-    if (s_date_sprites) {
-        gbitmap_destroy(s_date_sprites);
-        s_date_sprites = NULL;
-    }
-    if (s_am_pm_indicator) {
-        gbitmap_destroy(s_am_pm_indicator);
-        s_am_pm_indicator = NULL;
+// Pick up the values saved by widgets_save_cache and the battery history.
+// Cheap enough to run before the first frame; a step count from another day
+// is dropped.
+void widgets_restore_cache(void) {
+    battery_history_load();
+    update_battery_hours_text();
+    WidgetsCache cache;
+    if (!persist_exists(WIDGETS_CACHE_KEY) ||
+        persist_read_data(WIDGETS_CACHE_KEY, &cache, sizeof(cache)) != (int)sizeof(cache)) {
+        return;
     }
-    
-    // Reload all sprite sheets
-    s_battery_sprites = gbitmap_create_with_resource(RESOURCE_ID_BATTERY);
-    s_steps_sprites = gbitmap_create_with_resource(RESOURCE_ID_STEPS);
-    s_date_sprites = gbitmap_create_with_resource(RESOURCE_ID_DATE_SPRITES);
-    s_am_pm_indicator = gbitmap_create_with_resource(RESOURCE_ID_AM_PM_INDICATOR);
-    
-    // Invert palette colors for dark mode if enabled
-    if (s_settings_dark_mode) {
-        invert_bitmap_palette(s_battery_sprites);
-        invert_bitmap_palette(s_steps_sprites);
-        invert_bitmap_palette(s_date_sprites);
-        invert_bitmap_palette(s_am_pm_indicator);
+    s_battery_percent = cache.battery_percent;
+    time_t now = time(NULL);
+    struct tm *today = localtime(&now);
+    if (cache.day == (today->tm_year + 1900) * 1000 + today->tm_yday) {
+        s_step_count = cache.step_count;
     }
 }
 
+// Before the first frame: take the corner configuration and load only the
+// small bar sheets of the widgets drawn from cached values. Everything else
+// (other sheets, sensors) waits for widgets_init and widgets_set_config.
+void widgets_load_cached_sprites(WidgetConfig config) {
+    s_widget_config = config;
+    load_widget_fonts(false, WIDGETS_FROM_CACHE);
+}
+
+// Save the last-known values for the next launch
+static void widgets_save_cache(void) {
+    time_t now = time(NULL);
+    struct tm *today = localtime(&now);
+    WidgetsCache cache = {
+        .day = (today->tm_year + 1900) * 1000 + today->tm_yday,
+        .step_count = s_step_count,
+        .battery_percent = s_battery_percent
+    };
+    persist_write_data(WIDGETS_CACHE_KEY, &cache, sizeof(cache));
+}
+
+// Reload widget sprites (for dark mode changes)
+void widgets_reload_sprites(void) {
+    load_widget_fonts(true, WIDGETS_ALL);
+    sparkline_set_dark_mode(s_settings_dark_mode);
+}
+
 // Deinitialize widget system
 void widgets_deinit(void) {
-    // Unsubscribe from services
+    // Unsubscribe from services, and never leave the HR sensor sped up
     battery_state_service_unsubscribe();
     health_service_events_unsubscribe();
+    s_health_subscribed = false;
+    if (s_connection_subscribed) {
+        connection_service_unsubscribe();
+        s_connection_subscribed = false;
+    }
+    s_heart_rate_period = 0;
+    update_heart_rate_sampling();
+    widgets_save_cache();
     
     // Clean up sprite sheets
-    if (s_battery_sprites) {
-        gbitmap_destroy(s_battery_sprites);
-        s_battery_sprites = NULL;
+    unload_widget_fonts();
+    sparkline_deinit();
+}
+
+// Phone connected or disconnected
+static void connection_handler(bool connected) {
+    if (connected == s_connected) {
+        return;
     }
-    if (s_steps_sprites) {
-        gbitmap_destroy(s_steps_sprites);
-        s_steps_sprites = NULL;
+    s_connected = connected;
+    invalidate_post(INVALIDATE_CONNECTION);
+}
+
+// Listen for connection changes only while the connection widget is shown,
+// peeking once on subscribe for the starting state
+static void update_connection_subscription(void) {
+    bool want_events = widget_selected(WIDGET_CONNECTION);
+    if (want_events && !s_connection_subscribed) {
+        connection_service_subscribe((ConnectionHandlers) {
+            .pebble_app_connection_handler = connection_handler
+        });
+        s_connected = connection_service_peek_pebble_app_connection();
+    } else if (!want_events && s_connection_subscribed) {
+        connection_service_unsubscribe();
+    }
+    s_connection_subscribed = want_events;
+}
+
+// The sparkline's bitmap and buckets only exist while it is in a corner
+static void update_sparkline(void) {
+    if (widget_selected(WIDGET_STEP_SPARKLINE) && PBL_PLATFORM_TYPE_CURRENT != PlatformTypeAplite) {
+        sparkline_init(s_settings_dark_mode);
+    } else {
+        sparkline_deinit();
     }
-    if (s_date_sprites) {
-        gbitmap_destroy(s_date_sprites);
-        s_date_sprites = NULL;
+}
+
+// Format minutes after midnight in the face's 12/24 hour style
+static void mini_time_set(MiniTime *time, int minutes) {
+    int hour = minutes / 60;
+    bool use_24_hour = s_settings_use_24_hour_format ? true : clock_is_24h_style();
+    if (!use_24_hour) {
+        hour = hour % 12 == 0 ? 12 : hour % 12;
+    }
+    snprintf(time->hour_text, sizeof(time->hour_text), "%d", hour);
+    snprintf(time->minute_text, sizeof(time->minute_text), "%02d", minutes % 60);
+    time->width = font_text_width(&s_mini_font, time->hour_text) + MINI_COLON_WIDTH +
+                  font_text_width(&s_mini_font, time->minute_text);
+}
+
+// Fetch the day's sun times: from memory, from persist or, once a day, from
+// the sun math. Run on the day tick, on the hour tick (a daylight saving
+// change moves them by the hour) and when the location or corners change.
+static void update_sun_times(struct tm *now) {
+    s_sun_times = widget_selected(WIDGET_SUN_TIMES) ?
+        sun_times_for_day(s_latitude_e2, s_longitude_e2, now) : NULL;
+}
+
+// Format the next sunrise (or sunset, while the sun is up) for the sun widget
+// from the day's cached times. After sunset today's sunrise stands in for
+// tomorrow's, a minute or two off at most.
+static void update_sun_text(struct tm *now) {
+    s_sun_time.width = 0;
+    if (!widget_selected(WIDGET_SUN_TIMES)) {
+        return;
     }
-    if (s_am_pm_indicator) {
-        gbitmap_destroy(s_am_pm_indicator);
-        s_am_pm_indicator = NULL;
+    const SunTimes *times = s_sun_times;
+    if (!times || times->sunrise == SUN_NONE) {
+        // No location yet, or polar day/night
+        return;
     }
+    int minutes = now->tm_hour * 60 + now->tm_min;
+    int event = (minutes >= times->sunrise && minutes < times->sunset) ? times->sunset : times->sunrise;
+    mini_time_set(&s_sun_time, event);
+}
+
+// Time in the second zone from the local time: shift by the difference
+// between the two UTC offsets instead of converting through UTC
+static void update_second_tz_text(struct tm *now) {
+    int minutes = now->tm_hour * 60 + now->tm_min - now->tm_gmtoff / 60 + s_second_tz_offset;
+    minutes %= 24 * 60;
+    if (minutes < 0) {
+        minutes += 24 * 60;
+    }
+    mini_time_set(&s_second_tz_time, minutes);
+}
+
+// Refresh the cached times of the clock widgets that are shown
+static void update_time_widgets(struct tm *now) {
+    if (widget_selected(WIDGET_SUN_TIMES)) {
+        update_sun_text(now);
+    }
+    if (widget_selected(WIDGET_SECOND_TZ)) {
+        update_second_tz_text(now);
+    }
+}
+
+// Same, for settings changes that arrive between ticks
+static void update_time_widgets_now(void) {
+    time_t now = time(NULL);
+    struct tm *local = localtime(&now);
+    update_sun_times(local);
+    update_time_widgets(local);
+}
+
+// Moon phase at local noon, so the frame holds for the whole day
+static void update_moon_frame(struct tm *now) {
+    time_t noon = time(NULL) - (now->tm_hour * 3600 + now->tm_min * 60 + now->tm_sec) + 12 * 3600;
+    s_moon_frame = moon_phase_frame(noon);
 }
 
 // Set widget configuration
 void widgets_set_config(WidgetConfig config) {
     s_widget_config = config;
-    if (s_settings_debug_logging) {
-        APP_LOG(APP_LOG_LEVEL_INFO, "Widget config updated: top_left=%d, top_right=%d", 
-                s_widget_config.top_left_widget, s_widget_config.top_right_widget);
-    }
-    
-    // Check if step counter is being enabled via config change
-    bool step_counter_selected = (s_widget_config.top_left_widget == WIDGET_STEP_COUNT || 
-                                 s_widget_config.top_right_widget == WIDGET_STEP_COUNT);
+    LOG_DEBUG("Widget config updated: top_left=%d, top_right=%d", 
+              s_widget_config.top_left_widget, s_widget_config.top_right_widget);
     
-    if (step_counter_selected && PBL_PLATFORM_TYPE_CURRENT != PlatformTypeAplite) {
-        // When step counter is enabled via config change, try to subscribe to health services
-        // This allows detection of when health services become available after being disabled
-        bool subscription_success = health_service_events_subscribe(health_event_handler, NULL);
-        
-        if (subscription_success) {
-            // Health services are available, get current step count
-            time_t start = time_start_of_today();
-            time_t end = start + SECONDS_PER_DAY - 1;
-            HealthValue steps = health_service_sum(HealthMetricStepCount, start, end);
-            s_step_count = (int)steps;
-            if (s_settings_debug_logging) {
-                APP_LOG(APP_LOG_LEVEL_INFO, "Health services available - step counter activated with %d steps", s_step_count);
-            }
-        } else {
-            // Health services not available, set step count to 0
-            s_step_count = 0;
-            if (s_settings_debug_logging) {
-                APP_LOG(APP_LOG_LEVEL_INFO, "Health services not available - step counter shows empty state");
-            }
-        }
+    // Sheets for the new corners; mini_time_set below measures with them
+    load_widget_fonts(false, WIDGETS_ALL);
+    // Check if a health widget is being enabled or removed via config change
+    update_health_subscription();
+    update_sparkline();
+    update_connection_subscription();
+    update_time_widgets_now();
+    if (widget_selected(WIDGET_MOON_PHASE)) {
+        time_t now = time(NULL);
+        update_moon_frame(localtime(&now));
+    }
+}
+
+// A new hour: the sparkline gains a bucket, and the sun times follow a
+// daylight saving change (a no-op otherwise)
+void widgets_handle_hour_tick(struct tm *tick_time) {
+    if (sparkline_active()) {
+        sparkline_hour_tick();
+    }
+    if (widget_selected(WIDGET_SUN_TIMES)) {
+        update_sun_times(tick_time);
+        update_sun_text(tick_time);
     }
 }
 
+// A new minute: the clock widgets move on and the sun widget may have passed
+// sunrise or sunset
+void widgets_handle_minute_tick(struct tm *tick_time) {
+    update_time_widgets(tick_time);
+    // The worker can be stopped at any time (turned off in the settings, or
+    // replaced by another app's worker); take the step count back rather than
+    // let it freeze
+    if (s_worker_feeds_steps && !app_worker_is_running()) {
+        s_worker_feeds_steps = false;
+        update_health_subscription();
+        invalidate_post(INVALIDATE_STEPS);
+    }
+}
+
+// A new day: the sun times are recomputed and the moon moves on to the
+// day's phase
+void widgets_handle_day_tick(struct tm *tick_time) {
+    if (widget_selected(WIDGET_SUN_TIMES)) {
+        update_sun_times(tick_time);
+        update_sun_text(tick_time);
+    }
+    if (widget_selected(WIDGET_MOON_PHASE)) {
+        update_moon_frame(tick_time);
+    }
+}
+
+// Set the location used by the sun widget (hundredths of a degree)
+void widgets_set_location(int32_t latitude_e2, int32_t longitude_e2) {
+    s_latitude_e2 = latitude_e2;
+    s_longitude_e2 = longitude_e2;
+    update_time_widgets_now();
+}
+
+// Set the second time zone's offset from UTC, in minutes
+void widgets_set_second_tz_offset(int minutes) {
+    s_second_tz_offset = minutes;
+    update_time_widgets_now();
+}
+
+// Set the HR sampling period to use while the heart rate widget is shown
+void widgets_set_heart_rate_period(int seconds) {
+    s_heart_rate_period = seconds > 0 ? seconds : 0;
+    update_heart_rate_sampling();
+}
+
 // Draw month date widget
 static void draw_month_date_widget(GContext *ctx, int x, int y, struct tm *tick_time) {
-    int month = tick_time->tm_mon + 1; // Convert from 0-based to 1-based
-    
-    // Draw month using existing date sprites
-    // For single-digit months, we need to handle the positioning
-    if (month < 10) {
-        // Single digit month - draw at x position
-        draw_date_number(ctx, month, x, y);
-    } else {
-        // Two-digit month - draw tens and ones digits with 4px spacing
-        int month_tens = month / 10;
-        int month_ones = month % 10;
-        draw_date_number(ctx, month_tens, x, y);
-        draw_date_number(ctx, month_ones, x + DATE_WIDTH + 4, y); // Add 4px spacing
-    }
+    // Draw month using existing date sprites, 4px between digits
+    char text[3];
+    snprintf(text, sizeof(text), "%d", tick_time->tm_mon + 1); // Convert from 0-based to 1-based
+    draw_text(ctx, &s_date_font, text, x, y);
 }
 
 // Draw day date widget  
 static void draw_day_date_widget(GContext *ctx, int x, int y, struct tm *tick_time) {
-    int day = tick_time->tm_mday;
-    
-    // Draw day using existing date sprites
-    // For single-digit days, we need to handle the positioning
-    if (day < 10) {
-        // Single digit day - draw at x position
-        draw_date_number(ctx, day, x, y);
-    } else {
-        // Two-digit day - draw tens and ones digits with 4px spacing
-        int day_tens = day / 10;
-        int day_ones = day % 10;
-        draw_date_number(ctx, day_tens, x, y);
-        draw_date_number(ctx, day_ones, x + DATE_WIDTH + 4, y); // Add 4px spacing
-    }
+    // Draw day using existing date sprites, 4px between digits
+    char text[3];
+    snprintf(text, sizeof(text), "%d", tick_time->tm_mday);
+    draw_text(ctx, &s_date_font, text, x, y);
 }
 
 // Draw AM/PM indicator widget
 static void draw_am_pm_widget(GContext *ctx, int x, int y, struct tm *tick_time) {
-    if (!s_am_pm_indicator) {
-        return;
-    }
-    
     bool is_pm = (tick_time->tm_hour >= 12);
-    
-    // AM/PM indicator sprite dimensions: 20x14, 1 column, 2 rows
-    // Row 0: "P" (PM), Row 1: "A" (AM)
-    int sprite_width = 20;
-    int sprite_height = 14;
-    int frame_index = is_pm ? 0 : 1; // 0 = PM ("P"), 1 = AM ("A")
-    
-    GRect source_rect = GRect(0, frame_index * sprite_height, sprite_width, sprite_height);
-    GRect dest_rect = GRect(x, y, sprite_width, sprite_height);
-    
-    graphics_context_set_compositing_mode(ctx, GCompOpSet);
-    GBitmap *sprite_bitmap = gbitmap_create_as_sub_bitmap(s_am_pm_indicator, source_rect);
-    if (sprite_bitmap) {
-        graphics_draw_bitmap_in_rect(ctx, sprite_bitmap, dest_rect);
-        gbitmap_destroy(sprite_bitmap);
-    }
+    draw_text(ctx, &s_am_pm_font, is_pm ? "P" : "A", x, y);
 }
 
 // Draw battery indicator widget
 static void draw_battery_widget(GContext *ctx, int x, int y) {
-    if (!s_battery_sprites) return;
-    
     // Calculate which sprite frame to use based on 10% segments
     // 10 sprites total: 0 (full) to 9 (empty)
     // Simple 10% increment logic: 100-90, 90-80, 80-70, etc.
@@ -371,23 +646,11 @@ static void draw_battery_widget(GContext *ctx, int x, int y) {
     else if (s_battery_percent >= 10) frame_index = 8; // 10-19%: next level
     else frame_index = 9;                              // 0-9%: empty battery
     
-    // Battery sprite dimensions: 44x14, 1 column, 10 rows
-    int sprite_height = 14;
-    GRect source_rect = GRect(0, frame_index * sprite_height, 44, sprite_height);
-    GRect dest_rect = GRect(x, y, 44, sprite_height);
-    
-    graphics_context_set_compositing_mode(ctx, GCompOpSet);
-    GBitmap *sprite_bitmap = gbitmap_create_as_sub_bitmap(s_battery_sprites, source_rect);
-    if (sprite_bitmap) {
-        graphics_draw_bitmap_in_rect(ctx, sprite_bitmap, dest_rect);
-        gbitmap_destroy(sprite_bitmap);
-    }
+    draw_glyph(ctx, &s_battery_font, frame_index, x, y);
 }
 
 // Draw step count widget
 static void draw_steps_widget(GContext *ctx, int x, int y) {
-    if (!s_steps_sprites) return;
-    
     // Calculate which sprite frame to use based on step progression
     // Frame 0: any steps > 0 (first dot turns on immediately)
     // Frames 1-8: evenly spaced intervals from 12.5% to 100% of goal
@@ -403,24 +666,55 @@ static void draw_steps_widget(GContext *ctx, int x, int y) {
     else if (s_step_count > 0) frame_index = 1; // Any steps > 0 (first dot)
     else frame_index = 0; // No steps (top)
     
-    // Steps sprite dimensions: 44x14, 1 column, 9 rows
-    int sprite_height = 14;
-    GRect source_rect = GRect(0, frame_index * sprite_height, 44, sprite_height);
-    GRect dest_rect = GRect(x, y, 44, sprite_height);
-    
-    graphics_context_set_compositing_mode(ctx, GCompOpSet);
-    GBitmap *sprite_bitmap = gbitmap_create_as_sub_bitmap(s_steps_sprites, source_rect);
-    if (sprite_bitmap) {
-        graphics_draw_bitmap_in_rect(ctx, sprite_bitmap, dest_rect);
-        gbitmap_destroy(sprite_bitmap);
+    draw_glyph(ctx, &s_steps_font, frame_index, x, y);
+}
+
+// Heart rate text, empty until the sensor has a reading
+static void heart_rate_text(char *text, size_t size) {
+    if (s_heart_rate_bpm > 0) {
+        snprintf(text, size, "%d", s_heart_rate_bpm);
+    } else {
+        text[0] = '\0';
+    }
+}
+
+// Draw battery time remaining widget: estimated hours in the date digits, or
+// the battery bar until there is a trend (after a charge, or on a first run)
+static void draw_battery_time_widget(GContext *ctx, int x, int y) {
+    if (!s_battery_hours_text[0]) {
+        draw_battery_widget(ctx, x, y);
+        return;
     }
+    draw_text(ctx, &s_date_font, s_battery_hours_text, x, y);
+}
+
+// Draw heart rate widget
+static void draw_heart_rate_widget(GContext *ctx, int x, int y) {
+    // Beats per minute in the date digits
+    char text[4];
+    heart_rate_text(text, sizeof(text));
+    draw_text(ctx, &s_date_font, text, x, y);
+}
+
+// Draw an H:MM or HH:MM run in the mini digits, with a colon of two squares
+static void draw_mini_time(GContext *ctx, int x, int y, const MiniTime *time) {
+    if (!time->width) {
+        return;
+    }
+    x += draw_text(ctx, &s_mini_font, time->hour_text, x, y);
+    graphics_context_set_fill_color(ctx, s_settings_dark_mode ? GColorWhite : GColorBlack);
+    graphics_fill_rect(ctx, GRect(x + MINI_COLON_DOT_X, y + MINI_COLON_TOP_Y,
+                                  MINI_COLON_DOT_SIZE, MINI_COLON_DOT_SIZE), 0, GCornerNone);
+    graphics_fill_rect(ctx, GRect(x + MINI_COLON_DOT_X, y + MINI_COLON_BOTTOM_Y,
+                                  MINI_COLON_DOT_SIZE, MINI_COLON_DOT_SIZE), 0, GCornerNone);
+    INVALIDATE_COUNT_PAINTED(2 * MINI_COLON_DOT_SIZE, MINI_COLON_DOT_SIZE);
+    draw_text(ctx, &s_mini_font, time->minute_text, x + MINI_COLON_WIDTH, y);
 }
 
 // Draw a widget in the specified corner
-void widgets_draw_corner(GContext *ctx, CornerPosition corner, struct tm *tick_time) {
+// The anchor is the widget's top-left corner on the left, top-right corner on the right
+void widgets_draw_corner(GContext *ctx, CornerPosition corner, GPoint anchor, struct tm *tick_time) {
     WidgetType widget_type;
-    int padding_top = 10;
-    int padding_side = 10;
     
     // Determine which widget to draw based on corner position
     if (corner == CORNER_TOP_LEFT) {
@@ -429,46 +723,65 @@ void widgets_draw_corner(GContext *ctx, CornerPosition corner, struct tm *tick_t
         widget_type = s_widget_config.top_right_widget;
     }
     
-    // Debug logging (only if debug logging is enabled)
-    if (s_settings_debug_logging) {
-        APP_LOG(APP_LOG_LEVEL_INFO, "Drawing corner %d, widget type: %d", corner, widget_type);
-    }
+    // Compiled out unless LOG_LEVEL is LOG_LEVEL_DEBUG
+    LOG_DEBUG("Drawing corner %d, widget type: %d", corner, widget_type);
     
     // Skip if no widget selected
     if (widget_type == WIDGET_NONE) {
-        if (s_settings_debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "Skipping corner %d - no widget selected", corner);
-        }
+        LOG_DEBUG("Skipping corner %d - no widget selected", corner);
         return;
     }
     
     // Calculate position
-    int x, y = padding_top;
-    GRect bounds = layer_get_bounds(window_get_root_layer(window_stack_get_top_window()));
+    int x = anchor.x, y = anchor.y;
     
-    if (corner == CORNER_TOP_LEFT) {
-        x = padding_side;
-    } else {
+    if (corner != CORNER_TOP_LEFT) {
         // For right corner, we need to calculate based on widget width
         int widget_width = 0;
+        char text[3];
         switch (widget_type) {
             case WIDGET_MONTH_DATE:
-                widget_width = (tick_time->tm_mon + 1 < 10) ? DATE_WIDTH : (DATE_WIDTH * 2 + 4);
+                snprintf(text, sizeof(text), "%d", tick_time->tm_mon + 1);
+                widget_width = font_text_width(&s_date_font, text);
                 break;
             case WIDGET_DAY_DATE:
-                widget_width = (tick_time->tm_mday < 10) ? DATE_WIDTH : (DATE_WIDTH * 2 + 4);
+                snprintf(text, sizeof(text), "%d", tick_time->tm_mday);
+                widget_width = font_text_width(&s_date_font, text);
                 break;
             case WIDGET_AM_PM_INDICATOR:
-                widget_width = 20;
+                widget_width = AM_PM_WIDTH;
                 break;
             case WIDGET_BATTERY_INDICATOR:
             case WIDGET_STEP_COUNT:
-                widget_width = 44;
+            case WIDGET_STEP_SPARKLINE:
+                widget_width = BAR_WIDTH;
+                break;
+            case WIDGET_BATTERY_TIME:
+                widget_width = s_battery_hours_text[0] ?
+                    font_text_width(&s_date_font, s_battery_hours_text) : BAR_WIDTH;
+                break;
+            case WIDGET_HEART_RATE: {
+                char hr_text[4];
+                heart_rate_text(hr_text, sizeof(hr_text));
+                widget_width = font_text_width(&s_date_font, hr_text);
+                break;
+            }
+            case WIDGET_SUN_TIMES:
+                widget_width = s_sun_time.width;
+                break;
+            case WIDGET_SECOND_TZ:
+                widget_width = s_second_tz_time.width;
+                break;
+            case WIDGET_MOON_PHASE:
+                widget_width = MOON_SIZE;
+                break;
+            case WIDGET_CONNECTION:
+                widget_width = CONNECTION_WIDTH;
                 break;
             default:
                 widget_width = 30;
         }
-        x = bounds.size.w - widget_width - padding_side;
+        x = anchor.x - widget_width;
     }
     
     // Draw the selected widget
@@ -488,6 +801,28 @@ void widgets_draw_corner(GContext *ctx, CornerPosition corner, struct tm *tick_t
         case WIDGET_STEP_COUNT:
             draw_steps_widget(ctx, x, y);
             break;
+        case WIDGET_HEART_RATE:
+            draw_heart_rate_widget(ctx, x, y);
+            break;
+        case WIDGET_BATTERY_TIME:
+            draw_battery_time_widget(ctx, x, y);
+            break;
+        case WIDGET_STEP_SPARKLINE:
+            sparkline_draw(ctx, x, y);
+            break;
+        case WIDGET_SUN_TIMES:
+            draw_mini_time(ctx, x, y, &s_sun_time);
+            break;
+        case WIDGET_SECOND_TZ:
+            draw_mini_time(ctx, x, y, &s_second_tz_time);
+            break;
+        case WIDGET_MOON_PHASE:
+            draw_glyph(ctx, &s_moon_font, s_moon_frame, x, y);
+            break;
+        case WIDGET_CONNECTION:
+            // Frame 0 is linked, frame 1 is broken apart
+            draw_glyph(ctx, &s_connection_font, s_connected ? 0 : 1, x, y);
+            break;
         default:
             break;
     }
@@ -499,13 +834,42 @@ void widgets_handle_battery_update(void) {
 }
 
 
+// Snapshot from the background worker: take its aggregates as-is
+void widgets_handle_worker_message(uint16_t type, AppWorkerMessage *data) {
+    switch (type) {
+        case WORKER_MSG_STEPS:
+            if (!s_worker_feeds_steps) {
+                // The worker sums steps from now on, drop our own subscription
+                // unless the heart rate widget still needs it
+                s_worker_feeds_steps = true;
+                update_health_subscription();
+            }
+            s_step_count = (int)worker_unpack_steps(data);
+            if (s_live_sensor_updates) {
+                invalidate_post(INVALIDATE_STEPS);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// Forward battery events to another module
+void widgets_set_battery_listener(BatteryStateHandler listener) {
+    s_battery_listener = listener;
+}
+
+// Choose whether health events repaint immediately or wait for the next tick
+void widgets_set_live_sensor_updates(bool live) {
+    s_live_sensor_updates = live;
+    update_heart_rate_sampling();
+}
+
 // Set step goal
 void widgets_set_step_goal(int step_goal) {
     if (step_goal > 0) {
         s_step_goal = step_goal;
-        if (s_settings_debug_logging) {
-            APP_LOG(APP_LOG_LEVEL_INFO, "Step goal updated to: %d", s_step_goal);
-        }
+        LOG_DEBUG("Step goal updated to: %d", s_step_goal);
     }
 }
 
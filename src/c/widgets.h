@@ -10,7 +10,14 @@ typedef enum {
     WIDGET_DAY_DATE,
     WIDGET_AM_PM_INDICATOR,
     WIDGET_BATTERY_INDICATOR,
-    WIDGET_STEP_COUNT
+    WIDGET_STEP_COUNT,
+    WIDGET_HEART_RATE,
+    WIDGET_BATTERY_TIME,
+    WIDGET_STEP_SPARKLINE,
+    WIDGET_SUN_TIMES,
+    WIDGET_MOON_PHASE,
+    WIDGET_SECOND_TZ,
+    WIDGET_CONNECTION
 } WidgetType;
 
 // Corner positions
@@ -37,28 +44,50 @@ typedef struct Settings
     bool show_hour_minute_dots;
     int step_goal;
     WidgetConfig widget_config;
+    bool smooth_sweep;   // Second dot glides instead of stepping
+    int sweep_fps;       // Frame rate cap for the smooth sweep
+    int power_saver_threshold; // Battery percent for minute-only updates, 0 = never
+    bool tap_to_wake;          // Second dot only runs for a while after a wrist tap
+    int tap_burst_seconds;
+    bool night_schedule;       // No second updates between night_start_hour and night_end_hour
+    int night_start_hour;
+    int night_end_hour;
+    bool follow_quiet_time;    // No second updates while system Quiet Time is on
+    int heart_rate_period;     // HR sampling period (seconds) while shown, 0 = system default
+    int32_t latitude_e2;       // Hundredths of a degree, SUN_NO_LOCATION until set
+    int32_t longitude_e2;
+    int second_tz_offset;      // Second time zone, minutes east of UTC
+    bool background_worker;    // Run the worker for the step count
 } Settings;
 
 // Function declarations
 void widgets_init(void);
 void widgets_deinit(void);
+void widgets_restore_cache(void);
+void widgets_load_cached_sprites(WidgetConfig config);
 void widgets_set_config(WidgetConfig config);
-void widgets_draw_corner(GContext *ctx, CornerPosition corner, struct tm *tick_time);
+void widgets_draw_corner(GContext *ctx, CornerPosition corner, GPoint anchor, struct tm *tick_time);
 void widgets_handle_battery_update(void);
 void widgets_handle_health_update(void);
 void widgets_set_step_goal(int step_goal);
 void widgets_reload_sprites(void);
+void widgets_set_battery_listener(BatteryStateHandler listener);
+void widgets_set_live_sensor_updates(bool live);
+void widgets_handle_worker_message(uint16_t type, AppWorkerMessage *data);
+void widgets_set_heart_rate_period(int seconds);
+void widgets_handle_hour_tick(struct tm *tick_time);
+void widgets_handle_minute_tick(struct tm *tick_time);
+void widgets_handle_day_tick(struct tm *tick_time);
+void widgets_set_location(int32_t latitude_e2, int32_t longitude_e2);
+void widgets_set_second_tz_offset(int minutes);
 
 
-// Sprite sheet dimensions
-#define DATE_WIDTH 20
-#define DATE_HEIGHT 14
-#define DATE_SPRITES_PER_ROW 3
+// Sprite sheet dimensions (DATE_WIDTH, BAR_WIDTH, ...) generated by tools/glyphgen.py
+#include "glyphs.auto.h"
 
 // External access to settings
 extern bool s_settings_show_am_pm;
 extern bool s_settings_use_24_hour_format;
 extern bool s_settings_dark_mode;
-extern bool s_settings_debug_logging;
 
 #endif // WIDGETS_H
@@ -0,0 +1,26 @@
+#ifndef WORKER_PROTOCOL_H
+#define WORKER_PROTOCOL_H
+
+// Include after <pebble.h> (face) or <pebble_worker.h> (worker)
+
+// Messages between the face and its background worker (worker_src/c), each
+// one AppWorkerMessage of three uint16_t fields
+
+// Face -> worker: send every snapshot now (data fields unused)
+#define WORKER_MSG_SNAPSHOT_REQUEST 1
+
+// Worker -> face: steps so far today
+//   data0/data1: low/high 16 bits of the step count
+#define WORKER_MSG_STEPS 2
+
+static inline void worker_pack_steps(AppWorkerMessage *msg, int32_t steps) {
+    msg->data0 = (uint16_t)(steps & 0xFFFF);
+    msg->data1 = (uint16_t)((steps >> 16) & 0xFFFF);
+    msg->data2 = 0;
+}
+
+static inline int32_t worker_unpack_steps(const AppWorkerMessage *msg) {
+    return (int32_t)((uint32_t)msg->data0 | ((uint32_t)msg->data1 << 16));
+}
+
+#endif // WORKER_PROTOCOL_H
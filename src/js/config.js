@@ -33,6 +33,34 @@ module.exports = [
             "label": "Step Counter",
             "value": "5"
           },
+          {
+            "label": "Heart Rate",
+            "value": "6"
+          },
+          {
+            "label": "Battery Hours Left",
+            "value": "7"
+          },
+          {
+            "label": "Step History",
+            "value": "8"
+          },
+          {
+            "label": "Next Sunrise/Sunset",
+            "value": "9"
+          },
+          {
+            "label": "Moon Phase",
+            "value": "10"
+          },
+          {
+            "label": "Second Time Zone",
+            "value": "11"
+          },
+          {
+            "label": "Phone Connection",
+            "value": "12"
+          },
           {
             "label": "None",
             "value": "0"
@@ -66,6 +94,34 @@ module.exports = [
             "label": "Step Counter",
             "value": "5"
           },
+          {
+            "label": "Heart Rate",
+            "value": "6"
+          },
+          {
+            "label": "Battery Hours Left",
+            "value": "7"
+          },
+          {
+            "label": "Step History",
+            "value": "8"
+          },
+          {
+            "label": "Next Sunrise/Sunset",
+            "value": "9"
+          },
+          {
+            "label": "Moon Phase",
+            "value": "10"
+          },
+          {
+            "label": "Second Time Zone",
+            "value": "11"
+          },
+          {
+            "label": "Phone Connection",
+            "value": "12"
+          },
           {
             "label": "None",
             "value": "0"
@@ -84,6 +140,300 @@ module.exports = [
           "max": "50000",
           "step": "1000"
         }
+      },
+      {
+        "type": "toggle",
+        "messageKey": "BackgroundWorker",
+        "label": "Background Worker",
+        "defaultValue": false,
+        "description": "Keep counting steps in the background, so the step count is current as soon as the face opens. The watch asks before replacing another app's background worker.",
+        "capabilities": [
+          "HEALTH"
+        ]
+      },
+      {
+        "type": "select",
+        "messageKey": "HeartRatePeriod",
+        "label": "Heart Rate Sampling",
+        "defaultValue": "600",
+        "description": "How often to measure while the heart rate widget is shown; faster sampling uses more battery",
+        "options": [
+          {
+            "label": "System Default",
+            "value": "0"
+          },
+          {
+            "label": "Every 10 Minutes",
+            "value": "600"
+          },
+          {
+            "label": "Every 5 Minutes",
+            "value": "300"
+          },
+          {
+            "label": "Every Minute",
+            "value": "60"
+          }
+        ]
+      },
+      {
+        "type": "input",
+        "messageKey": "Latitude",
+        "label": "Latitude",
+        "defaultValue": "",
+        "description": "For the sunrise/sunset widget, in degrees (north is positive, e.g. 51.51)",
+        "attributes": {
+          "type": "number",
+          "min": "-90",
+          "max": "90",
+          "step": "0.01"
+        }
+      },
+      {
+        "type": "input",
+        "messageKey": "Longitude",
+        "label": "Longitude",
+        "defaultValue": "",
+        "description": "In degrees (east is positive, e.g. -0.13)",
+        "attributes": {
+          "type": "number",
+          "min": "-180",
+          "max": "180",
+          "step": "0.01"
+        }
+      },
+      {
+        "type": "select",
+        "messageKey": "SecondTimezoneOffset",
+        "label": "Second Time Zone",
+        "defaultValue": "0",
+        "description": "UTC offset for the second time zone widget; change it here when that zone starts or ends daylight saving time",
+        "options": [
+          {
+            "label": "UTC-12:00",
+            "value": "-720"
+          },
+          {
+            "label": "UTC-11:30",
+            "value": "-690"
+          },
+          {
+            "label": "UTC-11:00",
+            "value": "-660"
+          },
+          {
+            "label": "UTC-10:30",
+            "value": "-630"
+          },
+          {
+            "label": "UTC-10:00",
+            "value": "-600"
+          },
+          {
+            "label": "UTC-09:30",
+            "value": "-570"
+          },
+          {
+            "label": "UTC-09:00",
+            "value": "-540"
+          },
+          {
+            "label": "UTC-08:30",
+            "value": "-510"
+          },
+          {
+            "label": "UTC-08:00",
+            "value": "-480"
+          },
+          {
+            "label": "UTC-07:30",
+            "value": "-450"
+          },
+          {
+            "label": "UTC-07:00",
+            "value": "-420"
+          },
+          {
+            "label": "UTC-06:30",
+            "value": "-390"
+          },
+          {
+            "label": "UTC-06:00",
+            "value": "-360"
+          },
+          {
+            "label": "UTC-05:30",
+            "value": "-330"
+          },
+          {
+            "label": "UTC-05:00",
+            "value": "-300"
+          },
+          {
+            "label": "UTC-04:30",
+            "value": "-270"
+          },
+          {
+            "label": "UTC-04:00",
+            "value": "-240"
+          },
+          {
+            "label": "UTC-03:30",
+            "value": "-210"
+          },
+          {
+            "label": "UTC-03:00",
+            "value": "-180"
+          },
+          {
+            "label": "UTC-02:30",
+            "value": "-150"
+          },
+          {
+            "label": "UTC-02:00",
+            "value": "-120"
+          },
+          {
+            "label": "UTC-01:30",
+            "value": "-90"
+          },
+          {
+            "label": "UTC-01:00",
+            "value": "-60"
+          },
+          {
+            "label": "UTC-00:30",
+            "value": "-30"
+          },
+          {
+            "label": "UTC+00:00",
+            "value": "0"
+          },
+          {
+            "label": "UTC+00:30",
+            "value": "30"
+          },
+          {
+            "label": "UTC+01:00",
+            "value": "60"
+          },
+          {
+            "label": "UTC+01:30",
+            "value": "90"
+          },
+          {
+            "label": "UTC+02:00",
+            "value": "120"
+          },
+          {
+            "label": "UTC+02:30",
+            "value": "150"
+          },
+          {
+            "label": "UTC+03:00",
+            "value": "180"
+          },
+          {
+            "label": "UTC+03:30",
+            "value": "210"
+          },
+          {
+            "label": "UTC+04:00",
+            "value": "240"
+          },
+          {
+            "label": "UTC+04:30",
+            "value": "270"
+          },
+          {
+            "label": "UTC+05:00",
+            "value": "300"
+          },
+          {
+            "label": "UTC+05:30",
+            "value": "330"
+          },
+          {
+            "label": "UTC+05:45",
+            "value": "345"
+          },
+          {
+            "label": "UTC+06:00",
+            "value": "360"
+          },
+          {
+            "label": "UTC+06:30",
+            "value": "390"
+          },
+          {
+            "label": "UTC+07:00",
+            "value": "420"
+          },
+          {
+            "label": "UTC+07:30",
+            "value": "450"
+          },
+          {
+            "label": "UTC+08:00",
+            "value": "480"
+          },
+          {
+            "label": "UTC+08:30",
+            "value": "510"
+          },
+          {
+            "label": "UTC+08:45",
+            "value": "525"
+          },
+          {
+            "label": "UTC+09:00",
+            "value": "540"
+          },
+          {
+            "label": "UTC+09:30",
+            "value": "570"
+          },
+          {
+            "label": "UTC+10:00",
+            "value": "600"
+          },
+          {
+            "label": "UTC+10:30",
+            "value": "630"
+          },
+          {
+            "label": "UTC+11:00",
+            "value": "660"
+          },
+          {
+            "label": "UTC+11:30",
+            "value": "690"
+          },
+          {
+            "label": "UTC+12:00",
+            "value": "720"
+          },
+          {
+            "label": "UTC+12:30",
+            "value": "750"
+          },
+          {
+            "label": "UTC+12:45",
+            "value": "765"
+          },
+          {
+            "label": "UTC+13:00",
+            "value": "780"
+          },
+          {
+            "label": "UTC+13:30",
+            "value": "810"
+          },
+          {
+            "label": "UTC+14:00",
+            "value": "840"
+          }
+        ]
       }
     ]
   },
@@ -122,12 +472,329 @@ module.exports = [
         "defaultValue": true,
         "description": "Show the second dot in the background"
       },
+      {
+        "type": "toggle",
+        "messageKey": "SmoothSweep",
+        "label": "Smooth Second Sweep",
+        "defaultValue": false,
+        "description": "Glide the second dot instead of stepping once per second (uses more battery)"
+      },
+      {
+        "type": "select",
+        "messageKey": "SweepFps",
+        "label": "Sweep Frame Rate",
+        "defaultValue": "10",
+        "description": "Frames per second for the smooth sweep",
+        "options": [
+          {
+            "label": "5 FPS",
+            "value": "5"
+          },
+          {
+            "label": "10 FPS",
+            "value": "10"
+          },
+          {
+            "label": "30 FPS",
+            "value": "30"
+          }
+        ]
+      },
+      {
+        "type": "toggle",
+        "messageKey": "TapToWake",
+        "label": "Second Dot On Tap",
+        "defaultValue": false,
+        "description": "Only run the second dot for a while after you flick or tap your wrist"
+      },
+      {
+        "type": "slider",
+        "messageKey": "TapBurstSeconds",
+        "label": "Second Dot Duration",
+        "defaultValue": 15,
+        "description": "Seconds the second dot runs after a tap",
+        "min": 5,
+        "max": 60,
+        "step": 5
+      },
       {
         "type": "toggle",
         "messageKey": "ShowHourMinuteDots",
         "label": "Show Hour and Minute Dots",
         "defaultValue": true,
         "description": "Show the hour and minute dots in the background"
+      },
+      {
+        "type": "select",
+        "messageKey": "PowerSaverThreshold",
+        "label": "Battery Saver",
+        "defaultValue": "20",
+        "description": "Below this battery level the face only updates once a minute (both colon squares hollow); below twice it, the smooth sweep is turned off (lower square hollow)",
+        "options": [
+          {
+            "label": "Off",
+            "value": "0"
+          },
+          {
+            "label": "10%",
+            "value": "10"
+          },
+          {
+            "label": "20%",
+            "value": "20"
+          },
+          {
+            "label": "30%",
+            "value": "30"
+          }
+        ]
+      }
+    ]
+  },
+  {
+    "type": "section",
+    "items": [
+      {
+        "type": "heading",
+        "defaultValue": "Night Config"
+      },
+      {
+        "type": "toggle",
+        "messageKey": "FollowQuietTime",
+        "label": "Pause Seconds In Quiet Time",
+        "defaultValue": true,
+        "description": "Stop the second dot while the watch's Quiet Time is on"
+      },
+      {
+        "type": "toggle",
+        "messageKey": "NightSchedule",
+        "label": "Pause Seconds At Night",
+        "defaultValue": false,
+        "description": "Stop the second dot between the hours below"
+      },
+      {
+        "type": "select",
+        "messageKey": "NightStartHour",
+        "label": "Night Starts",
+        "defaultValue": "23",
+        "options": [
+          {
+            "label": "00:00",
+            "value": "0"
+          },
+          {
+            "label": "01:00",
+            "value": "1"
+          },
+          {
+            "label": "02:00",
+            "value": "2"
+          },
+          {
+            "label": "03:00",
+            "value": "3"
+          },
+          {
+            "label": "04:00",
+            "value": "4"
+          },
+          {
+            "label": "05:00",
+            "value": "5"
+          },
+          {
+            "label": "06:00",
+            "value": "6"
+          },
+          {
+            "label": "07:00",
+            "value": "7"
+          },
+          {
+            "label": "08:00",
+            "value": "8"
+          },
+          {
+            "label": "09:00",
+            "value": "9"
+          },
+          {
+            "label": "10:00",
+            "value": "10"
+          },
+          {
+            "label": "11:00",
+            "value": "11"
+          },
+          {
+            "label": "12:00",
+            "value": "12"
+          },
+          {
+            "label": "13:00",
+            "value": "13"
+          },
+          {
+            "label": "14:00",
+            "value": "14"
+          },
+          {
+            "label": "15:00",
+            "value": "15"
+          },
+          {
+            "label": "16:00",
+            "value": "16"
+          },
+          {
+            "label": "17:00",
+            "value": "17"
+          },
+          {
+            "label": "18:00",
+            "value": "18"
+          },
+          {
+            "label": "19:00",
+            "value": "19"
+          },
+          {
+            "label": "20:00",
+            "value": "20"
+          },
+          {
+            "label": "21:00",
+            "value": "21"
+          },
+          {
+            "label": "22:00",
+            "value": "22"
+          },
+          {
+            "label": "23:00",
+            "value": "23"
+          }
+        ]
+      },
+      {
+        "type": "select",
+        "messageKey": "NightEndHour",
+        "label": "Night Ends",
+        "defaultValue": "7",
+        "options": [
+          {
+            "label": "00:00",
+            "value": "0"
+          },
+          {
+            "label": "01:00",
+            "value": "1"
+          },
+          {
+            "label": "02:00",
+            "value": "2"
+          },
+          {
+            "label": "03:00",
+            "value": "3"
+          },
+          {
+            "label": "04:00",
+            "value": "4"
+          },
+          {
+            "label": "05:00",
+            "value": "5"
+          },
+          {
+            "label": "06:00",
+            "value": "6"
+          },
+          {
+            "label": "07:00",
+            "value": "7"
+          },
+          {
+            "label": "08:00",
+            "value": "8"
+          },
+          {
+            "label": "09:00",
+            "value": "9"
+          },
+          {
+            "label": "10:00",
+            "value": "10"
+          },
+          {
+            "label": "11:00",
+            "value": "11"
+          },
+          {
+            "label": "12:00",
+            "value": "12"
+          },
+          {
+            "label": "13:00",
+            "value": "13"
+          },
+          {
+            "label": "14:00",
+            "value": "14"
+          },
+          {
+            "label": "15:00",
+            "value": "15"
+          },
+          {
+            "label": "16:00",
+            "value": "16"
+          },
+          {
+            "label": "17:00",
+            "value": "17"
+          },
+          {
+            "label": "18:00",
+            "value": "18"
+          },
+          {
+            "label": "19:00",
+            "value": "19"
+          },
+          {
+            "label": "20:00",
+            "value": "20"
+          },
+          {
+            "label": "21:00",
+            "value": "21"
+          },
+          {
+            "label": "22:00",
+            "value": "22"
+          },
+          {
+            "label": "23:00",
+            "value": "23"
+          }
+        ]
+      }
+    ]
+  },
+  {
+    "type": "section",
+    "items": [
+      {
+        "type": "heading",
+        "defaultValue": "Diagnostics"
+      },
+      {
+        "type": "toggle",
+        "messageKey": "DumpLog",
+        "label": "Dump Event Log on Save",
+        "defaultValue": false,
+        "description": "Write the watch's recent event log (startup timings, power mode changes, dropped messages) to the app log when settings are saved. View it with pebble logs."
       }
     ]
   },
@@ -2,5 +2,51 @@
 var Clay = require('pebble-clay');
 // Load our Clay configuration file
 var clayConfig = require('./config');
-// Initialize Clay
-var clay = new Clay(clayConfig);
+var messageKeys = require('message_keys');
+// Initialize Clay; settings are sent from here rather than by Clay so they
+// can be tidied first
+var clay = new Clay(clayConfig, null, { autoHandleEvents: false });
+
+// Degrees to two decimals, or empty (no location) if not a number in range.
+// Keeps the text within the watch's inbox however many digits were typed.
+function cleanDegrees(value, limit) {
+  var degrees = parseFloat(value);
+  if (isNaN(degrees) || Math.abs(degrees) > limit) {
+    return '';
+  }
+  return degrees.toFixed(2);
+}
+
+// Whole steps within the range the settings page offers
+function cleanStepGoal(value) {
+  var steps = parseInt(value, 10);
+  if (isNaN(steps)) {
+    return '10000';
+  }
+  return String(Math.min(Math.max(steps, 1000), 50000));
+}
+
+Pebble.addEventListener('showConfiguration', function() {
+  Pebble.openURL(clay.generateUrl());
+});
+
+Pebble.addEventListener('webviewclosed', function(e) {
+  if (!e || !e.response) {
+    return;
+  }
+  var dict = clay.getSettings(e.response);
+  if (messageKeys.Latitude in dict) {
+    dict[messageKeys.Latitude] = cleanDegrees(dict[messageKeys.Latitude], 90);
+  }
+  if (messageKeys.Longitude in dict) {
+    dict[messageKeys.Longitude] = cleanDegrees(dict[messageKeys.Longitude], 180);
+  }
+  if (messageKeys.StepGoal in dict) {
+    dict[messageKeys.StepGoal] = cleanStepGoal(dict[messageKeys.StepGoal]);
+  }
+  Pebble.sendAppMessage(dict, function() {
+    console.log('Settings sent');
+  }, function(error) {
+    console.log('Settings not sent: ' + JSON.stringify(error));
+  });
+});
@@ -1,6 +1,2 @@
-// Import the Clay package
-var Clay = require('pebble-clay');
-// Load our Clay configuration file
-var clayConfig = require('./config');
-// Initialize Clay
-var clay = new Clay(clayConfig);
+// Same setup as index.js, for builds that use this entry point
+require('./index');
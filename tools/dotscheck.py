@@ -0,0 +1,200 @@
+#
+# Host check for the dot clipping in src/c/dots.c.
+#
+# Builds dots.c for the host with a stand-in pebble.h whose bitmap draw
+# records every pixel it would paint, then draws each dot kind at every
+# position around a set of occluders and checks that:
+#   - each stamp pixel outside the occluder is painted exactly once
+#   - nothing is painted inside the occluder or outside the stamp
+#   - each strip reads the matching part of the stamp sheet
+#   - the compositing mode is GCompOpSet at every blit
+#   - the avoided-pixel counter matches the pixels actually skipped
+# and reports how many pixels the clipping saves against full stamps.
+#
+# Run from anywhere, with a C compiler on the PATH (cc, or $CC):
+#   python3 tools/dotscheck.py
+# Exits non-zero on any mismatch.
+#
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+ROOT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+SOURCE_DIR = os.path.join(ROOT_DIR, 'src', 'c')
+
+# Stamp sizes glyphgen.py generates (emery is 12, everything else 8)
+DOT_SIZES = [8, 12]
+
+# Occluders as x, y, w, h: a time block on 144x168 and 200x228, one smaller
+# than a stamp (all four strips) and an empty one
+OCCLUDERS = [
+    (12, 58, 120, 52), (16, 80, 168, 68), (50, 50, 3, 3), (40, 40, 0, 0),
+]
+
+# Just enough of pebble.h for dots.c, log.h and invalidate.h
+PEBBLE_SHIM = r'''
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+typedef struct { int16_t x, y; } GPoint;
+typedef struct { int16_t w, h; } GSize;
+typedef struct { GPoint origin; GSize size; } GRect;
+#define GPoint(x, y) ((GPoint){ (x), (y) })
+#define GRect(x, y, w, h) ((GRect){ { (x), (y) }, { (w), (h) } })
+typedef union {
+    uint8_t argb;
+    struct { uint8_t b:2; uint8_t g:2; uint8_t r:2; uint8_t a:2; };
+} GColor;
+typedef enum {
+    GBitmapFormat1Bit, GBitmapFormat8Bit, GBitmapFormat1BitPalette,
+    GBitmapFormat2BitPalette, GBitmapFormat4BitPalette
+} GBitmapFormat;
+typedef enum { GCompOpAssign, GCompOpSet } GCompOp;
+typedef struct GBitmap { GRect bounds; } GBitmap;
+typedef struct GContext { GCompOp mode; } GContext;
+typedef struct Layer Layer;
+#define RESOURCE_ID_DOT_STAMPS 1
+#define APP_LOG(level, ...) (fprintf(stderr, __VA_ARGS__), fputc('\n', stderr))
+static GBitmap s_shim_sheet;
+static inline GBitmap *gbitmap_create_with_resource(uint32_t id) { return &s_shim_sheet; }
+static inline void gbitmap_destroy(GBitmap *bitmap) { }
+static inline GColor *gbitmap_get_palette(GBitmap *bitmap) { return NULL; }
+static inline GBitmapFormat gbitmap_get_format(GBitmap *bitmap) { return GBitmapFormat8Bit; }
+static inline void gbitmap_set_bounds(GBitmap *bitmap, GRect bounds) { bitmap->bounds = bounds; }
+static inline void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode) { ctx->mode = mode; }
+void graphics_draw_bitmap_in_rect(GContext *ctx, GBitmap *bitmap, GRect rect);
+'''
+
+# Prints one "fail ..." line per mismatch, then "total <cases> <painted>
+# <avoided> <full>" with pixel counts summed over the clipped cases
+DRIVER = r'''
+#include <stdlib.h>
+#include <pebble.h>
+#include "dots.h"
+#define CANVAS 320
+#define CANVAS_OFFSET 32
+static uint8_t s_hits[CANVAS][CANVAS];
+static GPoint s_origin;
+static DotKind s_kind;
+static int s_bad_blits;
+static uint32_t s_avoided;
+void invalidate_count_pixels(uint32_t painted, uint32_t avoided) { s_avoided += avoided; }
+void graphics_draw_bitmap_in_rect(GContext *ctx, GBitmap *bitmap, GRect rect) {
+    GRect src = bitmap->bounds;
+    if (ctx->mode != GCompOpSet || src.size.w != rect.size.w || src.size.h != rect.size.h ||
+        src.origin.x != rect.origin.x - s_origin.x ||
+        src.origin.y != (int)s_kind * DOT_SIZE + rect.origin.y - s_origin.y) {
+        s_bad_blits++;
+    }
+    for (int y = rect.origin.y; y < rect.origin.y + rect.size.h; y++) {
+        for (int x = rect.origin.x; x < rect.origin.x + rect.size.w; x++) {
+            s_hits[y + CANVAS_OFFSET][x + CANVAS_OFFSET]++;
+        }
+    }
+}
+static bool inside(GRect r, int x, int y) {
+    return x >= r.origin.x && x < r.origin.x + r.size.w && y >= r.origin.y && y < r.origin.y + r.size.h;
+}
+int main(int argc, char **argv) {
+    dots_load(false);
+    GContext ctx;
+    unsigned long cases = 0, painted = 0, avoided = 0, full = 0;
+    for (int i = 1; i + 3 < argc; i += 4) {
+        GRect occluder = GRect(atoi(argv[i]), atoi(argv[i + 1]), atoi(argv[i + 2]), atoi(argv[i + 3]));
+        for (int kind = DOT_SECOND; kind <= DOT_HOUR_MINUTE; kind++) {
+            for (int cy = occluder.origin.y - DOT_SIZE; cy <= occluder.origin.y + occluder.size.h + DOT_SIZE; cy++) {
+                for (int cx = occluder.origin.x - DOT_SIZE; cx <= occluder.origin.x + occluder.size.w + DOT_SIZE; cx++) {
+                    memset(s_hits, 0, sizeof(s_hits));
+                    s_kind = kind;
+                    s_origin = GPoint(cx - DOT_RADIUS, cy - DOT_RADIUS);
+                    GRect stamp = GRect(s_origin.x, s_origin.y, DOT_SIZE, DOT_SIZE);
+                    s_bad_blits = 0;
+                    s_avoided = 0;
+                    ctx.mode = GCompOpAssign;
+                    dots_draw(&ctx, kind, GPoint(cx, cy), occluder);
+                    int wrong = 0, hidden = 0, hits = 0;
+                    for (int y = 0; y < CANVAS; y++) {
+                        for (int x = 0; x < CANVAS; x++) {
+                            int sx = x - CANVAS_OFFSET, sy = y - CANVAS_OFFSET;
+                            bool in_stamp = inside(stamp, sx, sy);
+                            bool in_occluder = inside(occluder, sx, sy);
+                            hidden += in_stamp && in_occluder;
+                            wrong += s_hits[y][x] != (in_stamp && !in_occluder);
+                            hits += s_hits[y][x];
+                        }
+                    }
+                    if (wrong || s_bad_blits || s_avoided != (uint32_t)hidden) {
+                        printf("fail %d %d %d %d kind %d at %d,%d: %d wrong pixels, %d bad blits, "
+                               "%lu avoided against %d hidden\n", occluder.origin.x, occluder.origin.y,
+                               occluder.size.w, occluder.size.h, kind, cx, cy, wrong, s_bad_blits,
+                               (unsigned long)s_avoided, hidden);
+                    }
+                    if (hidden) {
+                        cases++;
+                        painted += hits;
+                        avoided += s_avoided;
+                        full += DOT_SIZE * DOT_SIZE;
+                    }
+                }
+            }
+        }
+    }
+    dots_unload();
+    printf("total %lu %lu %lu %lu\n", cases, painted, avoided, full);
+    return 0;
+}
+'''
+
+
+def build(work_dir, dot_size):
+    """Compile dots.c and the driver for one stamp size; returns the executable's path."""
+    with open(os.path.join(work_dir, 'pebble.h'), 'w') as f:
+        f.write(PEBBLE_SHIM)
+    # Stands in for the generated header, which dots.h picks up from its own directory
+    with open(os.path.join(work_dir, 'glyphs.auto.h'), 'w') as f:
+        f.write('#pragma once\n#define DOT_SIZE {}\n'.format(dot_size))
+    for name in ('dots.c', 'dots.h'):
+        shutil.copy(os.path.join(SOURCE_DIR, name), work_dir)
+    driver = os.path.join(work_dir, 'driver.c')
+    with open(driver, 'w') as f:
+        f.write(DRIVER)
+    exe = os.path.join(work_dir, 'dotscheck')
+    compiler = os.environ.get('CC', 'cc')
+    # LOG_LEVEL_DEBUG so dots.c reports what it avoided
+    subprocess.check_call([compiler, '-std=c11', '-O1', '-DLOG_LEVEL=4', '-I', work_dir,
+                           '-iquote', SOURCE_DIR, '-o', exe, driver,
+                           os.path.join(work_dir, 'dots.c')])
+    return exe
+
+
+def main():
+    ok = True
+    for dot_size in DOT_SIZES:
+        work_dir = tempfile.mkdtemp(prefix='dotscheck')
+        try:
+            exe = build(work_dir, dot_size)
+            args = [exe]
+            for occluder in OCCLUDERS:
+                args += [str(v) for v in occluder]
+            output = subprocess.check_output(args).decode().splitlines()
+        finally:
+            shutil.rmtree(work_dir)
+        for line in output:
+            if line.startswith('fail '):
+                print('  ' + line[5:])
+                ok = False
+        cases, painted, avoided, full = (int(v) for v in output[-1].split()[1:])
+        print('DOT_SIZE {}: {} clipped draws, {} px painted and {} px avoided '
+              'against {} px for full stamps ({:.1f}% saved)'.format(
+                  dot_size, cases, painted, avoided, full, 100.0 * avoided / full))
+        ok = ok and painted + avoided == full
+    return 0 if ok else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
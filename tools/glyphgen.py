@@ -0,0 +1,383 @@
+#
+# Build-time sprite generation for Fiftyeight.
+#
+# Loaded from the wscript with ctx.load('glyphgen', tooldir='tools'). Anything
+# that can be computed instead of drawn by hand (the clock dots, the moon) is rasterized
+# here so the watch only ever blits finished bitmaps, and the geometry of every
+# sprite sheet is read from the PNGs into src/c/glyphs.auto.h so the cell size
+# macros never have to be maintained by hand.
+#
+# Can also be run directly:
+#   python3 tools/glyphgen.py          regenerate dots, moon and glyphs.auto.h
+#   python3 tools/glyphgen.py derived  redo the derived sheets (mini digits) from the base art
+#   python3 tools/glyphgen.py emery    redo the ~emery sheets from the base art
+#
+import math
+import os
+import struct
+import sys
+import zlib
+
+try:
+    from waflib.Configure import conf
+except ImportError:
+    # Running standalone, outside of waf
+    def conf(f):
+        return f
+
+ROOT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+SPRITES_DIR = os.path.join(ROOT_DIR, 'resources', 'sprites')
+GLYPH_HEADER = os.path.join(ROOT_DIR, 'src', 'c', 'glyphs.auto.h')
+
+# Platforms and the resource tags the SDK would try for each, most specific first
+PLATFORM_TAGS = [
+    ('aplite', ['~aplite', '~bw', '~rect']),
+    ('basalt', ['~basalt', '~color', '~rect']),
+    ('chalk', ['~chalk', '~color', '~round']),
+    ('diorite', ['~diorite', '~bw', '~rect']),
+    ('emery', ['~emery', '~color', '~rect']),
+]
+
+# Platforms whose screens are big enough to want larger glyphs: (numerator, denominator)
+GLYPH_SCALE = {
+    'emery': (3, 2),
+}
+
+# Sprite sheets as (file, columns, rows, width macro, height macro, columns macro).
+# Sheets that share a macro must agree on its value.
+SHEETS = [
+    ('priority-digit.png', 3, 4, 'PRIORITY_WIDTH', 'SPRITE_HEIGHT', 'SPRITES_PER_ROW'),
+    ('subpriority-digit.png', 3, 4, 'SUBPRIORITY_WIDTH', 'SPRITE_HEIGHT', 'SPRITES_PER_ROW'),
+    ('midpriority-digit.png', 3, 4, 'MIDPRIORITY_WIDTH', 'SPRITE_HEIGHT', 'SPRITES_PER_ROW'),
+    ('day.png', 4, 4, 'DAY_WIDTH', 'DAY_HEIGHT', 'DAY_SPRITES_PER_ROW'),
+    ('date.png', 3, 4, 'DATE_WIDTH', 'DATE_HEIGHT', 'DATE_SPRITES_PER_ROW'),
+    ('A-P.png', 1, 2, 'AM_PM_WIDTH', 'AM_PM_HEIGHT', None),
+    ('battery.png', 1, 10, 'BAR_WIDTH', 'BAR_HEIGHT', None),
+    ('steps.png', 1, 9, 'BAR_WIDTH', 'BAR_HEIGHT', None),
+    ('dots.png', 1, 2, 'DOT_SIZE', 'DOT_SIZE', None),
+    ('mini-digit.png', 3, 4, 'MINI_WIDTH', 'MINI_HEIGHT', 'MINI_SPRITES_PER_ROW'),
+    ('moon.png', 1, 8, 'MOON_SIZE', 'MOON_SIZE', None),
+    ('connection.png', 1, 2, 'CONNECTION_WIDTH', 'CONNECTION_HEIGHT', None),
+]
+
+# Sheets rasterized here at every size rather than scaled from base art
+GENERATED_SHEETS = ('dots.png', 'moon.png')
+
+# Sheets derived from another sheet at a fixed scale, as (file, source, scale).
+# Like the ~<platform> variants they are committed so they can be touched up.
+# The date digits are drawn in 4px blocks, so halving them stays crisp.
+DERIVED_SHEETS = [
+    ('mini-digit.png', 'date.png', (1, 2)),
+]
+
+# Clock dot stamps (dots.png): one square frame per dot kind, stacked vertically
+# like battery.png. Frame order must match DotKind in src/c/dots.h.
+DOT_SIZE = 8
+DOT_FRAMES = [
+    (0x00, 0x00, 0x00),  # DOT_SECOND: black
+    (0x55, 0x55, 0x55),  # DOT_HOUR_MINUTE: dark gray
+]
+DOT_SUPERSAMPLE = 4
+
+# Moon phase frames (moon.png): one square frame per eighth of the synodic
+# month, new moon first, stacked vertically. The lit part is solid ink and the
+# dark part is left as a one pixel outline so a new moon is still visible.
+# Frame count must match MOON_FRAMES in src/c/moon.h.
+MOON_SIZE = 14
+MOON_FRAMES = 8
+
+
+def write_png(path, width, height, pixels):
+    """Write an 8-bit RGBA PNG. pixels is a list of rows of (r, g, b, a)."""
+    raw = bytearray()
+    for row in pixels:
+        raw.append(0)  # filter: none
+        for r, g, b, a in row:
+            raw.extend((r, g, b, a))
+
+    def chunk(tag, data):
+        body = tag + data
+        return struct.pack('>I', len(data)) + body + struct.pack('>I', zlib.crc32(body) & 0xffffffff)
+
+    png = b'\x89PNG\r\n\x1a\n'
+    png += chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, 8, 6, 0, 0, 0))
+    png += chunk(b'IDAT', zlib.compress(bytes(raw), 9))
+    png += chunk(b'IEND', b'')
+
+    # Only touch the file when the content changes so waf doesn't rebuild resources
+    if os.path.exists(path):
+        with open(path, 'rb') as f:
+            if f.read() == png:
+                return
+    with open(path, 'wb') as f:
+        f.write(png)
+
+
+def read_png(path):
+    """Read an 8-bit RGBA PNG (the format all sprite sheets are saved in).
+
+    Returns (width, height, rows of (r, g, b, a)).
+    """
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('{}: not a PNG'.format(path))
+    pos = 8
+    idat = b''
+    width = height = 0
+    while pos < len(data):
+        length, tag = struct.unpack('>I4s', data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        if tag == b'IHDR':
+            width, height, depth, color_type, _, _, interlace = struct.unpack('>IIBBBBB', body)
+            if depth != 8 or color_type != 6 or interlace:
+                raise ValueError('{}: expected 8-bit non-interlaced RGBA'.format(path))
+        elif tag == b'IDAT':
+            idat += body
+        elif tag == b'IEND':
+            break
+        pos += 12 + length
+    raw = zlib.decompress(idat)
+    stride = width * 4
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        line = raw[y * (stride + 1):(y + 1) * (stride + 1)]
+        kind, cur = line[0], bytearray(line[1:])
+        for i in range(stride):
+            a = cur[i - 4] if i >= 4 else 0
+            b = prev[i]
+            c = prev[i - 4] if i >= 4 else 0
+            if kind == 1:
+                cur[i] = (cur[i] + a) & 0xff
+            elif kind == 2:
+                cur[i] = (cur[i] + b) & 0xff
+            elif kind == 3:
+                cur[i] = (cur[i] + ((a + b) >> 1)) & 0xff
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                cur[i] = (cur[i] + pred) & 0xff
+        rows.append([tuple(cur[x * 4:x * 4 + 4]) for x in range(width)])
+        prev = cur
+    return width, height, rows
+
+
+def tagged_path(sprites_dir, filename, tag):
+    base, ext = os.path.splitext(filename)
+    return os.path.join(sprites_dir, base + tag + ext)
+
+
+def resolve_sheet(sprites_dir, filename, tags):
+    """The file the SDK would pick for a platform with these tags."""
+    for tag in tags:
+        path = tagged_path(sprites_dir, filename, tag)
+        if os.path.exists(path):
+            return path
+    return os.path.join(sprites_dir, filename)
+
+
+def scale_sheet(src, dst, columns, rows, scale):
+    """Nearest-neighbour scale each cell of a sheet on its own, so cells stay
+    whole pixels even when the factor isn't an integer."""
+    width, height, pixels = read_png(src)
+    num, den = scale
+    cell_w, cell_h = width // columns, height // rows
+    out_w, out_h = cell_w * num // den, cell_h * num // den
+    out = []
+    for y in range(out_h * rows):
+        row_index, cy = divmod(y, out_h)
+        sy = row_index * cell_h + cy * cell_h // out_h
+        line = []
+        for x in range(out_w * columns):
+            col_index, cx = divmod(x, out_w)
+            sx = col_index * cell_w + cx * cell_w // out_w
+            line.append(pixels[sy][sx])
+        out.append(line)
+    write_png(dst, out_w * columns, out_h * rows, out)
+
+
+def dot_coverage(x, y, size=DOT_SIZE):
+    """Fraction of pixel (x, y) covered by a disc of the given diameter."""
+    radius = size / 2.0
+    inside = 0
+    for sy in range(DOT_SUPERSAMPLE):
+        for sx in range(DOT_SUPERSAMPLE):
+            px = x + (sx + 0.5) / DOT_SUPERSAMPLE - radius
+            py = y + (sy + 0.5) / DOT_SUPERSAMPLE - radius
+            if px * px + py * py <= radius * radius:
+                inside += 1
+    return inside / float(DOT_SUPERSAMPLE * DOT_SUPERSAMPLE)
+
+
+def dot_pixels(color, bw, size=DOT_SIZE):
+    """Rasterize one dot frame.
+
+    Colour platforms get an anti-aliased edge (Pebble keeps 2 bits of alpha).
+    Black and white platforms get a hard edge, and grey is pre-dithered into a
+    checkerboard the same way graphics_fill_circle would dither it.
+    """
+    r, g, b = color
+    grey = (r, g, b) != (0, 0, 0) and (r, g, b) != (0xff, 0xff, 0xff)
+    rows = []
+    for y in range(size):
+        row = []
+        for x in range(size):
+            coverage = dot_coverage(x, y, size)
+            if bw:
+                on = coverage >= 0.5 and (not grey or (x + y) % 2 == 0)
+                row.append((0, 0, 0, 0xff) if on else (0xff, 0xff, 0xff, 0))
+            else:
+                alpha = int(round(coverage * 3)) * 0x55
+                row.append((r, g, b, alpha) if alpha else (0xff, 0xff, 0xff, 0))
+        rows.append(row)
+    return rows
+
+
+@conf
+def generate_dot_stamps(ctx=None, sprites_dir=SPRITES_DIR):
+    """Write dots.png (colour, anti-aliased), dots~bw.png (dithered) and a
+    larger dots~<platform>.png for every platform with a glyph scale."""
+    variants = [('', False, DOT_SIZE), ('~bw', True, DOT_SIZE)]
+    for platform, (num, den) in sorted(GLYPH_SCALE.items()):
+        variants.append(('~' + platform, False, DOT_SIZE * num // den))
+    for suffix, bw, size in variants:
+        pixels = []
+        for color in DOT_FRAMES:
+            pixels.extend(dot_pixels(color, bw, size))
+        write_png(os.path.join(sprites_dir, 'dots{}.png'.format(suffix)),
+                  size, size * len(DOT_FRAMES), pixels)
+
+
+def moon_pixels(frame, size=MOON_SIZE):
+    """Rasterize one moon phase frame, as seen from the northern hemisphere.
+
+    Hard edged in a single ink colour like the other widget sprites, so the
+    same file works on every platform and the palette swap inverts it.
+    """
+    ink, clear = (0, 0, 0, 0xff), (0xff, 0xff, 0xff, 0)
+    radius = size / 2.0
+    # cos of the phase angle puts the terminator; waxing lights the right side.
+    # Cubing it keeps new, quarter and full exact but pulls the crescent and
+    # gibbous terminators inward so they still read at this size.
+    cos_phase = math.cos(2.0 * math.pi * frame / MOON_FRAMES) ** 3
+    waxing = frame <= MOON_FRAMES // 2
+    rows = []
+    for y in range(size):
+        row = []
+        for x in range(size):
+            px = x + 0.5 - radius
+            py = y + 0.5 - radius
+            distance = math.sqrt(px * px + py * py)
+            if dot_coverage(x, y, size) < 0.5:
+                row.append(clear)
+                continue
+            half_width = math.sqrt(max(radius * radius - py * py, 0.0))
+            if waxing:
+                lit = px >= cos_phase * half_width
+            else:
+                lit = px <= -cos_phase * half_width
+            edge = distance > radius - 1.0
+            row.append(ink if lit or edge else clear)
+        rows.append(row)
+    return rows
+
+
+@conf
+def generate_moon_phases(ctx=None, sprites_dir=SPRITES_DIR):
+    """Write moon.png and a larger moon~<platform>.png for every platform
+    with a glyph scale."""
+    variants = [('', MOON_SIZE)]
+    for platform, (num, den) in sorted(GLYPH_SCALE.items()):
+        variants.append(('~' + platform, MOON_SIZE * num // den))
+    for suffix, size in variants:
+        pixels = []
+        for frame in range(MOON_FRAMES):
+            pixels.extend(moon_pixels(frame, size))
+        write_png(os.path.join(sprites_dir, 'moon{}.png'.format(suffix)),
+                  size, size * MOON_FRAMES, pixels)
+
+
+def sheet_geometry(sprites_dir, tags):
+    """Macro values for one platform, read from the sheets it will be built with."""
+    macros = {}
+    for filename, columns, rows, width_macro, height_macro, columns_macro in SHEETS:
+        path = resolve_sheet(sprites_dir, filename, tags)
+        with open(path, 'rb') as f:
+            width, height = struct.unpack('>II', f.read(24)[16:24])
+        if width % columns or height % rows:
+            raise ValueError('{}: {}x{} does not divide into {}x{} cells'.format(
+                path, width, height, columns, rows))
+        values = [(width_macro, width // columns), (height_macro, height // rows)]
+        if columns_macro:
+            values.append((columns_macro, columns))
+        for macro, value in values:
+            if macros.setdefault(macro, value) != value:
+                raise ValueError('{}: {} is {} but another sheet uses {}'.format(
+                    path, macro, value, macros[macro]))
+    return macros
+
+
+@conf
+def generate_glyph_header(ctx=None, sprites_dir=SPRITES_DIR, header=GLYPH_HEADER):
+    """Write glyphs.auto.h with the sprite cell sizes for every platform."""
+    lines = [
+        '// Generated by tools/glyphgen.py from the sprite sheets - do not edit',
+        '#pragma once',
+        '',
+    ]
+    keyword = '#if'
+    for platform, tags in PLATFORM_TAGS:
+        num, den = GLYPH_SCALE.get(platform, (1, 1))
+        lines.append('{} defined(PBL_PLATFORM_{})'.format(keyword, platform.upper()))
+        lines.append('#define GLYPH_SCALE_NUM {}'.format(num))
+        lines.append('#define GLYPH_SCALE_DEN {}'.format(den))
+        for macro, value in sorted(sheet_geometry(sprites_dir, tags).items()):
+            lines.append('#define {} {}'.format(macro, value))
+        keyword = '#elif'
+    lines.append('#else')
+    lines.append('#error "No sprite geometry for this platform, add it to tools/glyphgen.py"')
+    lines.append('#endif')
+    lines.append('')
+    lines.append('// Scale a hand-drawn length (spacing, colon) to match the glyphs')
+    lines.append('#define GLYPH_SCALE(v) ((v) * GLYPH_SCALE_NUM / GLYPH_SCALE_DEN)')
+    text = '\n'.join(lines) + '\n'
+    if os.path.exists(header):
+        with open(header) as f:
+            if f.read() == text:
+                return
+    with open(header, 'w') as f:
+        f.write(text)
+
+
+def generate_derived_sheets(sprites_dir=SPRITES_DIR):
+    """Redo the derived sheets from the sheets they are scaled from."""
+    layout = dict((sheet[0], (sheet[1], sheet[2])) for sheet in SHEETS)
+    for filename, source, scale in DERIVED_SHEETS:
+        columns, rows = layout[source]
+        scale_sheet(os.path.join(sprites_dir, source),
+                    os.path.join(sprites_dir, filename),
+                    columns, rows, scale)
+
+
+def generate_scaled_sheets(sprites_dir=SPRITES_DIR):
+    """Redo the ~<platform> sheets from the base art. The results are committed
+    so they can be touched up by hand afterwards."""
+    for platform, scale in sorted(GLYPH_SCALE.items()):
+        for filename, columns, rows, _, _, _ in SHEETS:
+            if filename in GENERATED_SHEETS:
+                continue  # Rasterized at the right size by their generators
+            scale_sheet(os.path.join(sprites_dir, filename),
+                        tagged_path(sprites_dir, filename, '~' + platform),
+                        columns, rows, scale)
+
+
+if __name__ == '__main__':
+    if 'derived' in sys.argv[1:]:
+        generate_derived_sheets()
+    if 'emery' in sys.argv[1:]:
+        generate_scaled_sheets()
+    generate_dot_stamps()
+    generate_moon_phases()
+    generate_glyph_header()
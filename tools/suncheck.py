@@ -0,0 +1,198 @@
+#
+# Host check for the sun widget's math.
+#
+# Builds src/c/math.c and src/c/sun.c for the host with a stand-in pebble.h
+# and compares them against references computed here in double precision:
+#   - my_asin and my_acos against Python's asin and acos over [-1, 1]
+#   - sun_compute against the full NOAA solar calculator (the spreadsheet
+#     algorithm, iterated to the event time) for a spread of latitudes,
+#     longitudes and days across a year
+#
+# Run from anywhere, with a C compiler on the PATH (cc, or $CC):
+#   python3 tools/suncheck.py
+# Exits non-zero if any error is over the limits below.
+#
+import datetime
+import math
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+ROOT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+SOURCE_DIR = os.path.join(ROOT_DIR, 'src', 'c')
+
+# Limits the watch is held to
+MAX_TRIG_ERROR = 1e-4  # Radians, my_asin/my_acos over the whole domain
+MAX_SUN_ERROR = 8      # Minutes, any single sunrise or sunset
+MAX_SUN_MEAN_ERROR = 2 # Minutes, averaged over every case
+
+# Locations in hundredths of a degree, from the equator to near the polar circle
+LOCATIONS = [
+    (-5000, -7000), (-3387, 15121), (0, 0), (1500, -1000), (3775, -12242),
+    (4071, -7401), (5150, -13), (6000, 2500), (6500, -2000),
+]
+YEAR = 2026
+DAY_STEP = 7
+TRIG_STEPS = 2000
+
+# Just enough of pebble.h for math.c and sun.c; persist always misses so
+# sun_times_for_day would recompute, though only sun_compute is called
+PEBBLE_SHIM = r'''
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+static inline bool persist_exists(uint32_t key) { return false; }
+static inline int persist_read_data(uint32_t key, void *buffer, size_t size) { return 0; }
+static inline int persist_write_data(uint32_t key, const void *data, size_t size) { return 0; }
+'''
+
+# Prints "asin <x> <my_asin> <my_acos>" lines, then "sun <lat> <lon> <yday>
+# <sunrise> <sunset>" lines (minutes after UTC midnight, -1 for none)
+DRIVER = r'''
+#include <stdlib.h>
+#include <pebble.h>
+#include "math.h"
+#include "sun.h"
+int main(int argc, char **argv) {
+    int steps = atoi(argv[1]);
+    for (int i = 0; i <= steps; i++) {
+        float x = -1.0f + 2.0f * i / steps;
+        printf("asin %.7f %.7f %.7f\n", x, my_asin(x), my_acos(x));
+    }
+    for (int i = 2; i + 2 < argc; i += 3) {
+        struct tm local = { 0 };
+        local.tm_year = YEAR - 1900;
+        local.tm_yday = atoi(argv[i + 2]);
+        local.tm_gmtoff = 0;
+        SunTimes times;
+        sun_compute(&times, atoi(argv[i]), atoi(argv[i + 1]), &local);
+        printf("sun %s %s %s %d %d\n", argv[i], argv[i + 1], argv[i + 2],
+               times.sunrise, times.sunset);
+    }
+    return 0;
+}
+'''
+
+
+def build(work_dir):
+    """Compile math.c, sun.c and the driver; returns the executable's path."""
+    with open(os.path.join(work_dir, 'pebble.h'), 'w') as f:
+        f.write(PEBBLE_SHIM)
+    driver = os.path.join(work_dir, 'driver.c')
+    with open(driver, 'w') as f:
+        f.write(DRIVER)
+    exe = os.path.join(work_dir, 'suncheck')
+    compiler = os.environ.get('CC', 'cc')
+    # _DEFAULT_SOURCE for tm_gmtoff; -iquote so math.c still gets the system <math.h>
+    subprocess.check_call([compiler, '-std=c11', '-O1', '-D_DEFAULT_SOURCE', '-DYEAR={}'.format(YEAR),
+                           '-I', work_dir, '-iquote', SOURCE_DIR, '-o', exe, driver,
+                           os.path.join(SOURCE_DIR, 'math.c'),
+                           os.path.join(SOURCE_DIR, 'sun.c')])
+    return exe
+
+
+def julian_day_number(date):
+    a = (14 - date.month) // 12
+    y = date.year + 4800 - a
+    m = date.month + 12 * a - 3
+    return date.day + (153 * m + 2) // 5 + 365 * y + y // 4 - y // 100 + y // 400 - 32045
+
+
+def noaa_event(latitude, longitude, yday, sign):
+    """Sunrise (sign -1) or sunset (+1) in minutes after UTC midnight from the
+    NOAA solar calculator, or None if the sun doesn't cross the horizon."""
+    date = datetime.date(YEAR, 1, 1) + datetime.timedelta(days=yday)
+    jdn = julian_day_number(date)
+    minutes = 720.0
+    # Re-evaluate the sun's position at the event time until it settles
+    for _ in range(3):
+        t = (jdn - 0.5 + minutes / 1440.0 - 2451545.0) / 36525.0
+        mean_longitude = (280.46646 + t * (36000.76983 + t * 0.0003032)) % 360
+        mean_anomaly = math.radians(357.52911 + t * (35999.05029 - 0.0001537 * t))
+        eccentricity = 0.016708634 - t * (0.000042037 + 0.0000001267 * t)
+        center = (math.sin(mean_anomaly) * (1.914602 - t * (0.004817 + 0.000014 * t)) +
+                  math.sin(2 * mean_anomaly) * (0.019993 - 0.000101 * t) +
+                  math.sin(3 * mean_anomaly) * 0.000289)
+        omega = math.radians(125.04 - 1934.136 * t)
+        apparent_longitude = math.radians(mean_longitude + center - 0.00569 -
+                                          0.00478 * math.sin(omega))
+        obliquity = (23 + (26 + (21.448 - t * (46.815 + t * (0.00059 - t * 0.001813))) / 60) / 60 +
+                     0.00256 * math.cos(omega))
+        obliquity = math.radians(obliquity)
+        declination = math.asin(math.sin(obliquity) * math.sin(apparent_longitude))
+        y = math.tan(obliquity / 2) ** 2
+        l0 = math.radians(mean_longitude)
+        equation_of_time = 4 * math.degrees(
+            y * math.sin(2 * l0) - 2 * eccentricity * math.sin(mean_anomaly) +
+            4 * eccentricity * y * math.sin(mean_anomaly) * math.cos(2 * l0) -
+            0.5 * y * y * math.sin(4 * l0) - 1.25 * eccentricity ** 2 * math.sin(2 * mean_anomaly))
+        lat = math.radians(latitude)
+        cos_hour_angle = (math.cos(math.radians(90.833)) / (math.cos(lat) * math.cos(declination)) -
+                          math.tan(lat) * math.tan(declination))
+        if abs(cos_hour_angle) > 1:
+            return None
+        hour_angle = math.degrees(math.acos(cos_hour_angle))
+        minutes = 720 - 4 * longitude - equation_of_time + sign * 4 * hour_angle
+    return round(minutes) % 1440
+
+
+def check_trig(lines):
+    worst = 0.0
+    for x, asin, acos in lines:
+        worst = max(worst, abs(asin - math.asin(x)), abs(acos - math.acos(x)))
+    print('my_asin/my_acos: max error {:.2e} rad over {} points'.format(worst, len(lines)))
+    return worst <= MAX_TRIG_ERROR
+
+
+def check_sun(lines):
+    ok = True
+    errors = []
+    by_latitude = {}
+    for lat_e2, lon_e2, yday, sunrise, sunset in lines:
+        for got, sign in ((sunrise, -1), (sunset, 1)):
+            ref = noaa_event(lat_e2 / 100.0, lon_e2 / 100.0, yday, sign)
+            if ref is None or got < 0:
+                # Right at the polar limits the two can disagree by a day
+                if (ref is None) != (got < 0):
+                    print('  polar day/night mismatch at {} {} day {}'.format(lat_e2, lon_e2, yday))
+                continue
+            error = abs(got - ref)
+            error = min(error, 1440 - error)
+            errors.append(error)
+            by_latitude[lat_e2] = max(by_latitude.get(lat_e2, 0), error)
+            if error > MAX_SUN_ERROR:
+                print('  {} {} day {}: {} against {}'.format(lat_e2, lon_e2, yday, got, ref))
+                ok = False
+    mean = sum(errors) / len(errors)
+    print('sun_compute: max error {} min, mean {:.2f} min over {} events'.format(
+        max(errors), mean, len(errors)))
+    for lat_e2 in sorted(by_latitude):
+        print('  latitude {:7.2f}: max error {} min'.format(lat_e2 / 100.0, by_latitude[lat_e2]))
+    return ok and mean <= MAX_SUN_MEAN_ERROR
+
+
+def main():
+    work_dir = tempfile.mkdtemp(prefix='suncheck')
+    try:
+        exe = build(work_dir)
+        args = [exe, str(TRIG_STEPS)]
+        for lat_e2, lon_e2 in LOCATIONS:
+            for yday in range(0, 365, DAY_STEP):
+                args += [str(lat_e2), str(lon_e2), str(yday)]
+        output = subprocess.check_output(args).decode().splitlines()
+    finally:
+        shutil.rmtree(work_dir)
+    trig = [tuple(map(float, line.split()[1:])) for line in output if line.startswith('asin ')]
+    sun = [tuple(map(int, line.split()[1:])) for line in output if line.startswith('sun ')]
+    ok = check_trig(trig)
+    ok = check_sun(sun) and ok
+    return 0 if ok else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
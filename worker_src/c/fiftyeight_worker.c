@@ -0,0 +1,62 @@
+#include <pebble_worker.h>
+#include "../../src/common/worker_protocol.h"
+
+// Background worker: keeps today's step count up to date while the face is
+// not running, and hands the face compact snapshots so it never sums steps
+// itself. The face only launches it on platforms with health, and keeps the
+// battery history itself (see battery_history.c).
+
+#if defined(PBL_HEALTH)
+static int32_t s_steps_today = 0;
+
+static void send_steps(void) {
+    AppWorkerMessage msg;
+    worker_pack_steps(&msg, s_steps_today);
+    app_worker_send_message(WORKER_MSG_STEPS, &msg);
+}
+
+static void health_handler(HealthEventType event, void *context) {
+    if (event != HealthEventMovementUpdate && event != HealthEventSignificantUpdate) return;
+    int32_t steps = (int32_t)health_service_sum_today(HealthMetricStepCount);
+    if (steps != s_steps_today) {
+        s_steps_today = steps;
+        send_steps();
+    }
+}
+#endif
+
+// The face asks for everything when it starts, so its first frame is current
+static void app_message_handler(uint16_t type, AppWorkerMessage *data) {
+    if (type == WORKER_MSG_SNAPSHOT_REQUEST) {
+#if defined(PBL_HEALTH)
+        send_steps();
+#endif
+    }
+}
+
+static void worker_init(void) {
+#if defined(PBL_HEALTH)
+    if (health_service_events_subscribe(health_handler, NULL)) {
+        s_steps_today = (int32_t)health_service_sum_today(HealthMetricStepCount);
+    }
+#endif
+    app_worker_message_subscribe(app_message_handler);
+    // A face that launched us cold asked for a snapshot before we were
+    // listening, so push one unasked
+#if defined(PBL_HEALTH)
+    send_steps();
+#endif
+}
+
+static void worker_deinit(void) {
+    app_worker_message_unsubscribe();
+#if defined(PBL_HEALTH)
+    health_service_events_unsubscribe();
+#endif
+}
+
+int main(void) {
+    worker_init();
+    worker_event_loop();
+    worker_deinit();
+}